@@ -53,7 +53,7 @@ namespace LegacyCode
 
         void render_at(int posx, int posy) const
         {
-            std::cout << "Rendering text '" << buffer_ << "' at: [" << posx << ", " << posy << "]" << std::endl;
+            std::cout << "Rendering text '" << buffer_ << "' at: [" << posx << ", " << posy << "]\n";
         }
 
         virtual ~Paragraph()
@@ -0,0 +1,56 @@
+#include "alloc_stats.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<size_t> allocations_count {};
+    std::atomic<size_t> allocated_bytes {};
+
+    void* counted_alloc(size_t size)
+    {
+        allocations_count.fetch_add(1, std::memory_order_relaxed);
+        allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+        if (void* ptr = std::malloc(size == 0 ? 1 : size))
+            return ptr;
+
+        throw std::bad_alloc {};
+    }
+}
+
+AllocStats::Snapshot AllocStats::snapshot() noexcept
+{
+    return Snapshot {allocations_count.load(std::memory_order_relaxed), allocated_bytes.load(std::memory_order_relaxed)};
+}
+
+void* operator new(size_t size)
+{
+    return counted_alloc(size);
+}
+
+void* operator new[](size_t size)
+{
+    return counted_alloc(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
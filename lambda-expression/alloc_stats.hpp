@@ -0,0 +1,42 @@
+#ifndef ALLOC_STATS_HPP
+#define ALLOC_STATS_HPP
+
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////////////////
+// AllocStats - counts calls to global operator new (see alloc_stats.cpp)
+
+namespace AllocStats
+{
+    struct Snapshot
+    {
+        size_t allocations;
+        size_t bytes;
+    };
+
+    Snapshot snapshot() noexcept;
+
+    // counts allocations made between construction and a call of allocations()/bytes()
+    class Scope
+    {
+        Snapshot start_;
+
+    public:
+        Scope() noexcept
+            : start_ {snapshot()}
+        {
+        }
+
+        size_t allocations() const noexcept
+        {
+            return snapshot().allocations - start_.allocations;
+        }
+
+        size_t bytes() const noexcept
+        {
+            return snapshot().bytes - start_.bytes;
+        }
+    };
+}
+
+#endif
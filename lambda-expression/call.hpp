@@ -0,0 +1,12 @@
+#ifndef CALL_HPP
+#define CALL_HPP
+
+#include <utility>
+
+template <typename F, typename... TArgs>
+decltype(auto) call(F&& f, TArgs&&... args)
+{
+    return f(std::forward<TArgs>(args)...);
+}
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef DARY_HEAP_HPP
+#define DARY_HEAP_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+// DaryHeap - min-heap (by TCompare) where every node has D children
+//            children of one node are adjacent - sift-down scans them in one or two cache lines
+//            & the tree is log(D) times shallower than binary heap
+
+template <typename T, size_t D = 4, typename TCompare = std::less<T>>
+class DaryHeap
+{
+    static_assert(D >= 2, "heap needs at least two children per node");
+
+    std::vector<T> items_;
+    [[no_unique_address]] TCompare compare_;
+
+    static size_t parent(size_t index) noexcept
+    {
+        return (index - 1) / D;
+    }
+
+    static size_t first_child(size_t index) noexcept
+    {
+        return index * D + 1;
+    }
+
+    void sift_up(size_t index)
+    {
+        T item = std::move(items_[index]);
+
+        while (index > 0)
+        {
+            const size_t parent_index = parent(index);
+            if (!compare_(item, items_[parent_index]))
+                break;
+
+            items_[index] = std::move(items_[parent_index]);
+            index = parent_index;
+        }
+
+        items_[index] = std::move(item);
+    }
+
+    void sift_down(size_t index)
+    {
+        const size_t size = items_.size();
+        T item = std::move(items_[index]);
+
+        while (true)
+        {
+            const size_t first = first_child(index);
+            if (first >= size)
+                break;
+
+            const size_t last = first + D < size ? first + D : size;
+            size_t best = first;
+            for (size_t child = first + 1; child < last; ++child)
+                if (compare_(items_[child], items_[best]))
+                    best = child;
+
+            if (!compare_(items_[best], item))
+                break;
+
+            items_[index] = std::move(items_[best]);
+            index = best;
+        }
+
+        items_[index] = std::move(item);
+    }
+
+public:
+    explicit DaryHeap(TCompare compare = TCompare {})
+        : compare_ {std::move(compare)}
+    {
+    }
+
+    void reserve(size_t capacity)
+    {
+        items_.reserve(capacity);
+    }
+
+    size_t size() const noexcept
+    {
+        return items_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return items_.empty();
+    }
+
+    const T& top() const noexcept
+    {
+        assert(!empty());
+        return items_.front();
+    }
+
+    void push(T item)
+    {
+        items_.push_back(std::move(item));
+        sift_up(items_.size() - 1);
+    }
+
+    T pop()
+    {
+        assert(!empty());
+
+        T result = std::move(items_.front());
+        if (items_.size() > 1)
+        {
+            items_.front() = std::move(items_.back());
+            items_.pop_back();
+            sift_down(0);
+        }
+        else
+            items_.pop_back();
+
+        return result;
+    }
+
+    // f(item) may change keys of any items - heap is rebuilt in O(n)
+    template <typename F>
+    void update_all(F f)
+    {
+        for (T& item : items_)
+            f(item);
+
+        if (items_.size() < 2)
+            return;
+
+        for (size_t i = parent(items_.size() - 1) + 1; i-- > 0;)
+            sift_down(i);
+    }
+};
+
+#endif
@@ -0,0 +1,294 @@
+#include "catch.hpp"
+#include "future.hpp"
+#include "task_queue.hpp"
+#include "thread_pool.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("TaskQueue::submit - returns future of result")
+{
+    TaskQueue tq;
+
+    Future<int> sum = tq.submit([](int a, int b) { return a + b; }, 40, 2);
+    Future<std::string> text = tq.submit([](std::string s) { return s + "!"; }, std::string {"Hello"});
+    Future<std::unique_ptr<int>> ptr = tq.submit([] { return std::make_unique<int>(13); });
+
+    int counter = 0;
+    Future<void> done = tq.submit([&counter] { ++counter; });
+
+    REQUIRE_FALSE(sum.is_ready());
+
+    tq.run();
+
+    REQUIRE(sum.get() == 42);
+    REQUIRE(text.get() == "Hello!");
+    REQUIRE(*ptr.get() == 13);
+    done.get();
+    REQUIRE(counter == 1);
+}
+
+TEST_CASE("TaskQueue::submit - closure too big for InplaceTask is moved to heap")
+{
+    TaskQueue tq;
+
+    const std::string greeting = "Hello";
+    const std::string name = "World";
+    Future<std::string> text = tq.submit([greeting, name] { return greeting + ", " + name + "!"; });
+    Future<size_t> length = tq.submit([](const std::string& a, const std::string& b) { return a.size() + b.size(); }, greeting, name);
+
+    tq.run();
+
+    REQUIRE(text.get() == "Hello, World!");
+    REQUIRE(length.get() == 10);
+}
+
+TEST_CASE("TaskQueue::submit - exception of task is passed to future")
+{
+    TaskQueue tq;
+
+    Future<int> result = tq.submit([]() -> int { throw std::runtime_error("task failed"); });
+    tq.run();
+
+    REQUIRE_THROWS_AS(result.get(), std::runtime_error);
+}
+
+TEST_CASE("Future - broken promise")
+{
+    Future<int> result;
+    {
+        Promise<int> promise;
+        result = promise.get_future();
+    }
+
+    REQUIRE_THROWS_AS(result.get(), std::future_error);
+}
+
+TEST_CASE("Future::then - continuations")
+{
+    TaskQueue tq;
+
+    SECTION("attached before result is set - run by completing task")
+    {
+        Future<std::string> result = tq.submit([] { return 21; })
+                                         .then([](int x) { return x * 2; })
+                                         .then([](int x) { return std::to_string(x); });
+
+        REQUIRE_FALSE(result.is_ready());
+        tq.run();
+        REQUIRE(result.get() == "42");
+    }
+
+    SECTION("attached after result is set - run inline")
+    {
+        Future<int> source = tq.submit([] { return 21; });
+        tq.run();
+
+        bool has_run = false;
+        Future<void> result = source.then([&has_run](int x) { has_run = (x == 21); });
+
+        REQUIRE(has_run);
+        REQUIRE(result.is_ready());
+    }
+
+    SECTION("exception skips continuations")
+    {
+        int calls = 0;
+        Future<int> result = tq.submit([]() -> int { throw std::runtime_error("task failed"); })
+                                 .then([&calls](int x) { ++calls; return x; })
+                                 .then([&calls](int x) { ++calls; return x; });
+        tq.run();
+
+        REQUIRE_THROWS_AS(result.get(), std::runtime_error);
+        REQUIRE(calls == 0);
+    }
+
+    SECTION("continuation of void future")
+    {
+        Future<int> result = tq.submit([] {}).then([] { return 42; });
+        tq.run();
+
+        REQUIRE(result.get() == 42);
+    }
+}
+
+TEST_CASE("when_all")
+{
+    TaskQueue tq;
+
+    SECTION("results in order of futures")
+    {
+        std::vector<Future<int>> futures;
+        for (int i = 0; i < 10; ++i)
+            futures.push_back(tq.submit([i] { return i * i; }));
+
+        Future<std::vector<int>> all = when_all(std::move(futures));
+        REQUIRE_FALSE(all.is_ready());
+
+        tq.run();
+        REQUIRE(all.get() == std::vector {0, 1, 4, 9, 16, 25, 36, 49, 64, 81});
+    }
+
+    SECTION("void futures")
+    {
+        int counter = 0;
+        std::vector<Future<void>> futures;
+        for (int i = 0; i < 10; ++i)
+            futures.push_back(tq.submit([&counter] { ++counter; }));
+
+        Future<void> all = when_all(std::move(futures));
+        tq.run();
+
+        all.get();
+        REQUIRE(counter == 10);
+    }
+
+    SECTION("exception")
+    {
+        std::vector<Future<int>> futures;
+        futures.push_back(tq.submit([] { return 1; }));
+        futures.push_back(tq.submit([]() -> int { throw std::runtime_error("task failed"); }));
+        futures.push_back(tq.submit([] { return 3; }));
+
+        Future<std::vector<int>> all = when_all(std::move(futures));
+        tq.run();
+
+        REQUIRE_THROWS_AS(all.get(), std::runtime_error);
+    }
+
+    SECTION("no futures")
+    {
+        REQUIRE(when_all(std::vector<Future<int>> {}).get().empty());
+    }
+}
+
+TEST_CASE("when_any")
+{
+    std::vector<Promise<std::string>> promises(3);
+    std::vector<Future<std::string>> futures;
+    for (auto& promise : promises)
+        futures.push_back(promise.get_future());
+
+    Future<WhenAnyResult<std::string>> any = when_any(std::move(futures));
+    REQUIRE_FALSE(any.is_ready());
+
+    promises[1].set_value("second");
+    REQUIRE(any.is_ready());
+
+    promises[0].set_value("first");
+    promises[2].set_exception(std::make_exception_ptr(std::runtime_error("ignored")));
+
+    auto [index, value] = any.get();
+    REQUIRE(index == 1);
+    REQUIRE(value == "second");
+}
+
+TEST_CASE("Future - result set by other thread")
+{
+    const int count = 1'000;
+
+    for (int i = 0; i < count; ++i)
+    {
+        Promise<int> promise;
+        Future<int> source = promise.get_future();
+
+        std::thread producer {[promise = std::move(promise), i]() mutable { promise.set_value(i); }};
+
+        // continuation is run by producer or inline here - whichever comes second
+        std::atomic<std::thread::id> continuation_thread {};
+        Future<int> result = source.then([&continuation_thread](int x) {
+            continuation_thread = std::this_thread::get_id();
+            return x + 1;
+        });
+
+        const int value = result.get();
+        const std::thread::id producer_id = producer.get_id();
+        producer.join();
+
+        const std::thread::id runner = continuation_thread.load();
+        REQUIRE(value == i + 1);
+        REQUIRE((runner == producer_id || runner == std::this_thread::get_id()));
+    }
+}
+
+TEST_CASE("TaskQueue::submit - fan-out/fan-in vs. std::async", "[.][benchmark]")
+{
+    const int tasks_count = 64;
+
+    auto work = [](int i) {
+        long long x = i;
+        for (int j = 0; j < 1'000; ++j)
+            x = x * 6364136223846793005LL + 1442695040888963407LL;
+        return x;
+    };
+
+    BENCHMARK("TaskQueue::submit + when_all + then")
+    {
+        TaskQueue tq;
+
+        std::vector<Future<long long>> futures;
+        futures.reserve(tasks_count);
+        for (int i = 0; i < tasks_count; ++i)
+            futures.push_back(tq.submit(work, i));
+
+        Future<long long> total = when_all(std::move(futures)).then([](std::vector<long long> results) {
+            return std::accumulate(results.begin(), results.end(), 0LL);
+        });
+
+        tq.run();
+        return total.get();
+    };
+
+    ThreadPool pool;
+
+    BENCHMARK("ThreadPool + Promise + when_all + then")
+    {
+        std::vector<Future<long long>> futures;
+        futures.reserve(tasks_count);
+        for (int i = 0; i < tasks_count; ++i)
+        {
+            Promise<long long> promise;
+            futures.push_back(promise.get_future());
+            pool.post([promise = std::move(promise), work, i]() mutable { promise.set_result_of([&] { return work(i); }); });
+        }
+
+        Future<long long> total = when_all(std::move(futures)).then([](std::vector<long long> results) {
+            return std::accumulate(results.begin(), results.end(), 0LL);
+        });
+
+        return total.get();
+    };
+
+    BENCHMARK("std::async(deferred) + std::future")
+    {
+        std::vector<std::future<long long>> futures;
+        futures.reserve(tasks_count);
+        for (int i = 0; i < tasks_count; ++i)
+            futures.push_back(std::async(std::launch::deferred, work, i));
+
+        long long total = 0;
+        for (auto& f : futures)
+            total += f.get();
+        return total;
+    };
+
+    BENCHMARK("std::async(async) + std::future")
+    {
+        std::vector<std::future<long long>> futures;
+        futures.reserve(tasks_count);
+        for (int i = 0; i < tasks_count; ++i)
+            futures.push_back(std::async(std::launch::async, work, i));
+
+        long long total = 0;
+        for (auto& f : futures)
+            total += f.get();
+        return total;
+    };
+}
@@ -0,0 +1,532 @@
+#ifndef FUTURE_HPP
+#define FUTURE_HPP
+
+#include "call.hpp"
+#include "inplace_task.hpp"
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+template <typename T>
+class Future;
+
+template <typename T>
+class Promise;
+
+namespace Detail
+{
+    struct VoidResult
+    {
+    };
+
+    template <typename T>
+    using StoredResult = std::conditional_t<std::is_void_v<T>, VoidResult, T>;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // FutureState - result shared by Promise & Future
+    //               pending -> ready or pending -> continuation_set -> ready (no mutex)
+    //               whoever comes second (producer or continuation) runs the continuation
+
+    template <typename T>
+    class FutureState
+    {
+        enum : int
+        {
+            pending,
+            continuation_set,
+            ready
+        };
+
+        using Continuation = InplaceTask<56, HeapFallback::enabled>;
+
+        std::atomic<int> ref_count_ {1};
+        std::atomic<int> state_ {pending};
+        std::variant<std::monostate, StoredResult<T>, std::exception_ptr> result_;
+        Continuation continuation_;
+
+        // continuation owns reference of consumed future
+        void run_continuation() noexcept
+        {
+            continuation_();
+            continuation_ = nullptr;
+            release();
+        }
+
+        void complete() noexcept
+        {
+            if (state_.exchange(ready, std::memory_order_acq_rel) == continuation_set)
+                run_continuation();
+            else
+                state_.notify_all();
+        }
+
+    public:
+        void add_ref() noexcept
+        {
+            ref_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void release() noexcept
+        {
+            if (ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                delete this;
+        }
+
+        template <typename... TArgs>
+        void set_value(TArgs&&... args)
+        {
+            result_.template emplace<1>(std::forward<TArgs>(args)...);
+            complete();
+        }
+
+        void set_exception(std::exception_ptr e) noexcept
+        {
+            result_.template emplace<2>(std::move(e));
+            complete();
+        }
+
+        bool is_ready() const noexcept
+        {
+            return state_.load(std::memory_order_acquire) == ready;
+        }
+
+        void wait() const noexcept
+        {
+            int state;
+            while ((state = state_.load(std::memory_order_acquire)) != ready)
+                state_.wait(state, std::memory_order_acquire);
+        }
+
+        bool has_exception() const noexcept
+        {
+            return result_.index() == 2;
+        }
+
+        std::exception_ptr exception() const noexcept
+        {
+            return std::get<2>(result_);
+        }
+
+        StoredResult<T>& value() noexcept
+        {
+            return std::get<1>(result_);
+        }
+
+        // continuation must not throw - it is called at most once
+        // runs inline on this thread if result is already set
+        template <typename F>
+        void set_continuation(F&& f)
+        {
+            continuation_ = Continuation {std::forward<F>(f)};
+
+            int expected = pending;
+            if (!state_.compare_exchange_strong(expected, continuation_set, std::memory_order_acq_rel, std::memory_order_acquire))
+                run_continuation();
+        }
+    };
+
+    template <typename F, typename T>
+    struct ContinuationResult
+    {
+        using type = std::invoke_result_t<F&, T&&>;
+    };
+
+    template <typename F>
+    struct ContinuationResult<F, void>
+    {
+        using type = std::invoke_result_t<F&>;
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Future - move-only handle of result produced (possibly) on other thread
+//          get() blocks until result is set, then() attaches continuation
+//          which is run inline by the thread that completes the result
+
+template <typename T>
+class [[nodiscard]] Future
+{
+    Detail::FutureState<T>* state_ {};
+
+    friend class Promise<T>;
+
+    template <typename U>
+    friend class Future;
+
+    template <typename U>
+    friend auto when_all(std::vector<Future<U>> futures);
+
+    template <typename U>
+    friend auto when_any(std::vector<Future<U>> futures);
+
+    explicit Future(Detail::FutureState<T>* state) noexcept
+        : state_ {state}
+    {
+    }
+
+    // consumes future - f(state) is called once when result is set
+    template <typename F>
+    void on_complete(F&& f)
+    {
+        assert(valid());
+
+        Detail::FutureState<T>* state = std::exchange(state_, nullptr);
+        state->set_continuation([state, f = std::forward<F>(f)]() mutable noexcept { f(*state); });
+    }
+
+public:
+    using value_type = T;
+
+    Future() noexcept = default;
+
+    Future(const Future&) = delete;
+    Future& operator=(const Future&) = delete;
+
+    Future(Future&& other) noexcept
+        : state_ {std::exchange(other.state_, nullptr)}
+    {
+    }
+
+    Future& operator=(Future&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (state_)
+                state_->release();
+            state_ = std::exchange(other.state_, nullptr);
+        }
+
+        return *this;
+    }
+
+    ~Future()
+    {
+        if (state_)
+            state_->release();
+    }
+
+    bool valid() const noexcept
+    {
+        return state_ != nullptr;
+    }
+
+    bool is_ready() const noexcept
+    {
+        assert(valid());
+        return state_->is_ready();
+    }
+
+    void wait() const noexcept
+    {
+        assert(valid());
+        state_->wait();
+    }
+
+    // blocks until result is set - TaskQueue must be run() by other thread before
+    // consumes future, rethrows exception of task
+    T get()
+    {
+        wait();
+
+        std::unique_ptr<Detail::FutureState<T>, void (*)(Detail::FutureState<T>*)> state {
+            std::exchange(state_, nullptr), [](Detail::FutureState<T>* s) { s->release(); }};
+
+        if (state->has_exception())
+            std::rethrow_exception(state->exception());
+
+        if constexpr (!std::is_void_v<T>)
+            return std::move(state->value());
+    }
+
+    // f(T) (or f() for Future<void>) is called with result - exception of this future
+    // skips f & is passed to returned future
+    template <typename F>
+    auto then(F&& f) -> Future<typename Detail::ContinuationResult<std::decay_t<F>, T>::type>
+    {
+        using TResult = typename Detail::ContinuationResult<std::decay_t<F>, T>::type;
+
+        Promise<TResult> promise;
+        Future<TResult> next = promise.get_future();
+
+        on_complete([promise = std::move(promise), f = std::forward<F>(f)](Detail::FutureState<T>& source) mutable noexcept {
+            if (source.has_exception())
+                promise.set_exception(source.exception());
+            else if constexpr (std::is_void_v<T>)
+                promise.set_result_of([&]() -> decltype(auto) { return call(f); });
+            else
+                promise.set_result_of([&]() -> decltype(auto) { return call(f, std::move(source.value())); });
+        });
+
+        return next;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Promise - producer side of Future
+//           destroyed without result - future gets std::future_error (broken_promise)
+
+template <typename T>
+class Promise
+{
+    Detail::FutureState<T>* state_;
+    bool future_retrieved_ {};
+
+    Detail::FutureState<T>* take_state() noexcept
+    {
+        assert(state_ != nullptr && "result already set");
+        return std::exchange(state_, nullptr);
+    }
+
+public:
+    Promise()
+        : state_ {new Detail::FutureState<T>}
+    {
+    }
+
+    Promise(const Promise&) = delete;
+    Promise& operator=(const Promise&) = delete;
+
+    Promise(Promise&& other) noexcept
+        : state_ {std::exchange(other.state_, nullptr)}
+        , future_retrieved_ {other.future_retrieved_}
+    {
+    }
+
+    Promise& operator=(Promise&& other) noexcept
+    {
+        Promise temp {std::move(other)};
+        std::swap(state_, temp.state_);
+        std::swap(future_retrieved_, temp.future_retrieved_);
+
+        return *this;
+    }
+
+    ~Promise()
+    {
+        if (state_)
+            set_exception(std::make_exception_ptr(std::future_error {std::future_errc::broken_promise}));
+    }
+
+    Future<T> get_future()
+    {
+        assert(state_ != nullptr && !future_retrieved_);
+
+        future_retrieved_ = true;
+        state_->add_ref();
+
+        return Future<T> {state_};
+    }
+
+    // exception thrown by constructor of value is passed to future
+    template <typename... TArgs>
+    void set_value(TArgs&&... args) noexcept
+    {
+        Detail::FutureState<T>* state = take_state();
+        try
+        {
+            state->set_value(std::forward<TArgs>(args)...);
+        }
+        catch (...)
+        {
+            state->set_exception(std::current_exception());
+        }
+        state->release();
+    }
+
+    void set_exception(std::exception_ptr e) noexcept
+    {
+        Detail::FutureState<T>* state = take_state();
+        state->set_exception(std::move(e));
+        state->release();
+    }
+
+    // sets result of f() or exception thrown by f
+    template <typename F>
+    void set_result_of(F&& f) noexcept
+    {
+        try
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                call(std::forward<F>(f));
+                set_value();
+            }
+            else
+                set_value(call(std::forward<F>(f)));
+        }
+        catch (...)
+        {
+            set_exception(std::current_exception());
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// when_all - future of all results (in order of futures)
+//            first exception wins, results of other futures are then dropped
+
+template <typename T>
+using WhenAllResult = std::conditional_t<std::is_void_v<T>, void, std::vector<Detail::StoredResult<T>>>;
+
+template <typename T>
+auto when_all(std::vector<Future<T>> futures)
+{
+    using TResult = WhenAllResult<T>;
+
+    struct Join
+    {
+        std::vector<std::optional<Detail::StoredResult<T>>> results;
+        std::atomic<size_t> remaining;
+        std::atomic<bool> has_failed {};
+        std::exception_ptr error; // written by the first failed future only
+        Promise<TResult> promise;
+
+        explicit Join(size_t count)
+            : results(std::is_void_v<T> ? 0 : count)
+            , remaining {count}
+        {
+        }
+
+        void finish() noexcept
+        {
+            if (has_failed.load(std::memory_order_relaxed))
+                promise.set_exception(error);
+            else if constexpr (std::is_void_v<T>)
+                promise.set_value();
+            else
+                promise.set_result_of([this] {
+                    TResult values;
+                    values.reserve(results.size());
+                    for (auto& result : results)
+                        values.push_back(std::move(*result));
+                    return values;
+                });
+        }
+    };
+
+    auto join = std::make_shared<Join>(futures.size());
+    Future<TResult> result = join->promise.get_future();
+
+    if (futures.empty())
+    {
+        join->finish();
+        return result;
+    }
+
+    for (size_t i = 0; i < futures.size(); ++i)
+    {
+        futures[i].on_complete([join, i](Detail::FutureState<T>& source) noexcept {
+            if (source.has_exception())
+            {
+                if (!join->has_failed.exchange(true, std::memory_order_relaxed))
+                    join->error = source.exception();
+            }
+            else if constexpr (!std::is_void_v<T>)
+                join->results[i].emplace(std::move(source.value()));
+
+            // acq_rel - the last one sees results & error of all others
+            if (join->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                join->finish();
+        });
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// when_any - future of the first completed result (with its index)
+//            results of other futures are dropped
+
+template <typename T>
+struct WhenAnyResult
+{
+    size_t index;
+    T value;
+};
+
+template <>
+struct WhenAnyResult<void>
+{
+    size_t index;
+};
+
+template <typename T>
+auto when_any(std::vector<Future<T>> futures)
+{
+    using TResult = WhenAnyResult<T>;
+
+    struct Race
+    {
+        std::atomic<bool> is_decided {};
+        Promise<TResult> promise;
+    };
+
+    auto race = std::make_shared<Race>();
+    Future<TResult> result = race->promise.get_future();
+
+    if (futures.empty())
+    {
+        race->promise.set_exception(std::make_exception_ptr(std::invalid_argument {"when_any of no futures"}));
+        return result;
+    }
+
+    for (size_t i = 0; i < futures.size(); ++i)
+    {
+        futures[i].on_complete([race, i](Detail::FutureState<T>& source) noexcept {
+            if (race->is_decided.exchange(true, std::memory_order_acq_rel))
+                return;
+
+            if (source.has_exception())
+                race->promise.set_exception(source.exception());
+            else if constexpr (std::is_void_v<T>)
+                race->promise.set_value(TResult {i});
+            else
+                race->promise.set_result_of([&] { return TResult {i, std::move(source.value())}; });
+        });
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// submit() of executors - callable & args stored in task that fulfils Promise
+
+namespace Detail
+{
+    template <typename F, typename... TArgs>
+    using SubmitResult = std::invoke_result_t<std::decay_t<F>&, std::decay_t<TArgs>&&...>;
+
+    // closure too big for InplaceTask (without heap fallback) has to be moved to heap
+    template <typename TTask, typename TClosure>
+    constexpr bool needs_heap_v = [] {
+        if constexpr (requires { TTask::template can_store<TClosure>; })
+            return !TTask::template can_store<TClosure>;
+        else
+            return false;
+    }();
+
+    // void() closure stored in TTask that stores f & args and sets promise with result of f(args...)
+    template <typename TTask, typename F, typename... TArgs>
+    auto make_promised_call(Promise<SubmitResult<F, TArgs...>> promise, F&& f, TArgs&&... args)
+    {
+        auto promised_call = [promise = std::move(promise), f = std::forward<F>(f), ... args = std::forward<TArgs>(args)]() mutable {
+            promise.set_result_of([&]() -> decltype(auto) { return call(f, std::move(args)...); });
+        };
+
+        if constexpr (needs_heap_v<TTask, decltype(promised_call)>)
+            return [promised_call = std::make_unique<decltype(promised_call)>(std::move(promised_call))] { (*promised_call)(); };
+        else
+            return promised_call;
+    }
+}
+
+#endif
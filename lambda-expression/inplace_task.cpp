@@ -0,0 +1,133 @@
+#include "catch.hpp"
+#include "alloc_stats.hpp"
+#include "inplace_task.hpp"
+#include "task_queue.hpp"
+#include <array>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+static_assert(sizeof(InplaceTask<>) == 64, "default task fits in one cache line");
+
+TEST_CASE("InplaceTask - stores closure inline")
+{
+    int counter = 0;
+
+    AllocStats::Scope alloc_scope;
+    InplaceTask<> task = [&counter] { ++counter; };
+    InplaceTask<> target = std::move(task);
+    const size_t allocations = alloc_scope.allocations();
+
+    REQUIRE(allocations == 0);
+    REQUIRE_FALSE(task);
+
+    target();
+    target();
+    REQUIRE(counter == 2);
+
+    SECTION("mutable closure")
+    {
+        InplaceTask<> generator = [&counter, seed = 100]() mutable { counter = ++seed; };
+        generator();
+        generator();
+        REQUIRE(counter == 102);
+    }
+
+    SECTION("empty task")
+    {
+        InplaceTask<> empty;
+        REQUIRE_FALSE(empty);
+
+        target = nullptr;
+        REQUIRE_FALSE(target);
+    }
+}
+
+TEST_CASE("InplaceTask - move-only closures")
+{
+    auto uptr = std::make_unique<int>(13);
+    int result = 0;
+
+    TaskQueue tq;
+    tq.post([uptr = std::move(uptr), &result] { result = *uptr; });
+    tq.run();
+
+    REQUIRE(result == 13);
+}
+
+TEST_CASE("InplaceTask - destroys closure once")
+{
+    auto shared = std::make_shared<int>(1);
+    {
+        InplaceTask<> task = [shared] {};
+        InplaceTask<> target = std::move(task);
+        REQUIRE(shared.use_count() == 2);
+    }
+
+    REQUIRE(shared.use_count() == 1);
+}
+
+TEST_CASE("InplaceTask - heap fallback for big closures")
+{
+    std::array<int, 64> big_capture {};
+    big_capture.back() = 42;
+    int result = 0;
+
+    InplaceTask<16, HeapFallback::enabled> task = [big_capture, &result] { result = big_capture.back(); };
+    auto target = std::move(task);
+    target();
+
+    REQUIRE(result == 42);
+}
+
+namespace
+{
+    // closure with 40 bytes of captures - over the inline limit of std::function in libstdc++ & MSVC
+    template <typename TTaskQueue>
+    long long submit_and_run(TTaskQueue& tq, int tasks_count)
+    {
+        long long sum = 0;
+        long long* result = &sum;
+        for (int i = 0; i < tasks_count; ++i)
+        {
+            const long long a = i, b = 2 * i, c = 3 * i, d = 4 * i;
+            tq.post([result, a, b, c, d] { *result += a + b + c + d; });
+        }
+        tq.run();
+        return sum;
+    }
+}
+
+TEST_CASE("InplaceTask vs. std::function - allocations & dispatch", "[.][benchmark]")
+{
+    const int tasks_count = 1'000;
+
+    BasicTaskQueue<std::function<void()>> function_queue;
+    TaskQueue inplace_queue;
+
+    submit_and_run(function_queue, tasks_count); // warm-up of queue buffers
+    submit_and_run(inplace_queue, tasks_count);
+
+    AllocStats::Scope function_scope;
+    submit_and_run(function_queue, tasks_count);
+    const size_t function_allocations = function_scope.allocations();
+
+    AllocStats::Scope inplace_scope;
+    submit_and_run(inplace_queue, tasks_count);
+    const size_t inplace_allocations = inplace_scope.allocations();
+
+    std::cout << "allocations per " << tasks_count << " tasks - std::function: " << function_allocations
+              << ", InplaceTask: " << inplace_allocations << "\n";
+
+    BENCHMARK("TaskQueue<std::function<void()>>")
+    {
+        return submit_and_run(function_queue, tasks_count);
+    };
+
+    BENCHMARK("TaskQueue<InplaceTask<>>")
+    {
+        return submit_and_run(inplace_queue, tasks_count);
+    };
+}
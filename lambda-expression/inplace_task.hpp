@@ -0,0 +1,153 @@
+#ifndef INPLACE_TASK_HPP
+#define INPLACE_TASK_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////
+// InplaceTask - move-only void() callable stored in inline buffer of Size bytes
+//               closure that does not fit is a compile-time error,
+//               unless heap fallback is opted in with HeapFallback::enabled
+
+enum class HeapFallback
+{
+    disabled,
+    enabled
+};
+
+template <size_t Size = 56, HeapFallback Fallback = HeapFallback::disabled>
+class InplaceTask
+{
+    struct Ops
+    {
+        void (*invoke)(void* storage);
+        void (*move)(void* target, void* source) noexcept; // nullptr - size bytes are copied
+        void (*destroy)(void* storage) noexcept;           // nullptr - trivially destructible
+        size_t size;                                       // bytes of closure (or pointer) in storage - 0 for empty closure
+    };
+
+    template <typename F>
+    static constexpr bool fits_inline_v = sizeof(F) <= Size && alignof(F) <= alignof(std::max_align_t)
+        && std::is_nothrow_move_constructible_v<F>;
+
+    template <typename F>
+    static constexpr Ops inline_ops {
+        [](void* storage) { (*static_cast<F*>(storage))(); },
+        std::is_trivially_copyable_v<F> ? nullptr : +[](void* target, void* source) noexcept {
+            new (target) F(std::move(*static_cast<F*>(source)));
+            static_cast<F*>(source)->~F();
+        },
+        std::is_trivially_destructible_v<F> ? nullptr : +[](void* storage) noexcept { static_cast<F*>(storage)->~F(); },
+        std::is_empty_v<F> ? 0 : sizeof(F)};
+
+    template <typename F>
+    static constexpr Ops heap_ops {
+        [](void* storage) { (**static_cast<F**>(storage))(); },
+        nullptr, // pointer is copied
+        [](void* storage) noexcept { delete *static_cast<F**>(storage); },
+        sizeof(F*)};
+
+    alignas(std::max_align_t) std::byte storage_[Size];
+    const Ops* ops_ {};
+
+    void move_from(InplaceTask& other) noexcept
+    {
+        if (!other.ops_)
+            return;
+
+        if (other.ops_->move)
+            other.ops_->move(storage_, other.storage_);
+        else
+            std::memcpy(storage_, other.storage_, other.ops_->size); // bytes past closure are uninitialized
+
+        ops_ = std::exchange(other.ops_, nullptr);
+    }
+
+    void reset() noexcept
+    {
+        if (ops_ && ops_->destroy)
+            ops_->destroy(storage_);
+        ops_ = nullptr;
+    }
+
+public:
+    static constexpr size_t inline_capacity = Size;
+
+    // F can be stored (inline or with heap fallback)
+    template <typename F>
+    static constexpr bool can_store = fits_inline_v<F> || Fallback == HeapFallback::enabled;
+
+    InplaceTask() noexcept = default;
+
+    InplaceTask(std::nullptr_t) noexcept
+    {
+    }
+
+    template <typename F, typename TClosure = std::decay_t<F>,
+        typename = std::enable_if_t<!std::is_same_v<TClosure, InplaceTask> && std::is_invocable_v<TClosure&>>>
+    InplaceTask(F&& f)
+    {
+        static_assert(Size >= sizeof(void*), "buffer must hold at least a pointer");
+
+        if constexpr (fits_inline_v<TClosure>)
+        {
+            new (storage_) TClosure(std::forward<F>(f));
+            ops_ = &inline_ops<TClosure>;
+        }
+        else
+        {
+            static_assert(Fallback == HeapFallback::enabled,
+                "closure is too big for InplaceTask - increase Size or enable HeapFallback");
+
+            *reinterpret_cast<TClosure**>(storage_) = new TClosure(std::forward<F>(f));
+            ops_ = &heap_ops<TClosure>;
+        }
+    }
+
+    InplaceTask(const InplaceTask&) = delete;
+    InplaceTask& operator=(const InplaceTask&) = delete;
+
+    InplaceTask(InplaceTask&& other) noexcept
+    {
+        move_from(other);
+    }
+
+    InplaceTask& operator=(InplaceTask&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            move_from(other);
+        }
+
+        return *this;
+    }
+
+    InplaceTask& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    ~InplaceTask()
+    {
+        reset();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return ops_ != nullptr;
+    }
+
+    void operator()()
+    {
+        assert(ops_ != nullptr);
+        ops_->invoke(storage_);
+    }
+};
+
+#endif
@@ -0,0 +1,231 @@
+#include "catch.hpp"
+#include "dary_heap.hpp"
+#include "priority_task_queue.hpp"
+#include "task_queue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+TEST_CASE("DaryHeap - pops items in order")
+{
+    std::mt19937 rnd {42};
+    std::vector<int> items(1'000);
+    for (int& item : items)
+        item = static_cast<int>(rnd() % 100);
+
+    DaryHeap<int, 4> heap;
+    for (int item : items)
+        heap.push(item);
+
+    std::vector<int> popped;
+    while (!heap.empty())
+        popped.push_back(heap.pop());
+
+    std::sort(items.begin(), items.end());
+    REQUIRE(popped == items);
+
+    SECTION("update_all restores heap order")
+    {
+        DaryHeap<int, 3, std::greater<>> max_heap;
+        for (int i = 0; i < 100; ++i)
+            max_heap.push(i);
+
+        max_heap.update_all([](int& item) { item = (item * 37) % 100; });
+
+        int previous = max_heap.pop();
+        while (!max_heap.empty())
+        {
+            const int item = max_heap.pop();
+            REQUIRE(item <= previous);
+            previous = item;
+        }
+    }
+}
+
+TEST_CASE("PriorityTaskQueue - order of tasks")
+{
+    PriorityTaskQueue tq {PriorityTaskQueue::no_aging};
+    std::string order;
+
+    SECTION("priority classes, FIFO within class")
+    {
+        tq.post([&order] { order += "l1 "; }, {.priority = Priority::low});
+        tq.post([&order] { order += "n1 "; });
+        tq.post([&order] { order += "h1 "; }, {.priority = Priority::high});
+        tq.post([&order] { order += "l2 "; }, {.priority = Priority::low});
+        tq.post([&order] { order += "h2 "; }, {.priority = Priority::high});
+
+        tq.run();
+        REQUIRE(order == "h1 h2 n1 l1 l2 ");
+    }
+
+    SECTION("earliest deadline first within class")
+    {
+        const auto now = PriorityTaskQueue::Clock::now();
+
+        tq.post([&order] { order += "none "; });
+        tq.post([&order] { order += "30ms "; }, {.deadline = now + 30ms});
+        tq.post([&order] { order += "10ms "; }, {.deadline = now + 10ms});
+        tq.post([&order] { order += "high "; }, {.priority = Priority::high, .deadline = now + 1s});
+        tq.post([&order] { order += "20ms "; }, {.deadline = now + 20ms});
+
+        tq.run();
+        REQUIRE(order == "high 10ms 20ms 30ms none ");
+    }
+
+    SECTION("tasks posted by running task")
+    {
+        tq.post([&] {
+            order += "n1 ";
+            tq.post([&order] { order += "l "; }, {.priority = Priority::low});
+            tq.post([&order] { order += "h "; }, {.priority = Priority::high});
+        });
+        tq.post([&order] { order += "n2 "; });
+
+        tq.run();
+        REQUIRE(order == "n1 h n2 l ");
+    }
+}
+
+TEST_CASE("PriorityTaskQueue - aging promotes waiting tasks")
+{
+    PriorityTaskQueue tq {1ms};
+    std::string order;
+
+    tq.post([&order] { order += "low "; }, {.priority = Priority::low});
+    std::this_thread::sleep_for(5ms); // waits longer than two aging thresholds - promoted to high
+    tq.post([&order] { order += "high "; }, {.priority = Priority::high});
+    tq.post([&order] { order += "normal "; });
+
+    tq.run();
+    REQUIRE(order == "low high normal ");
+}
+
+TEST_CASE("PriorityTaskQueue - zero aging threshold disables aging")
+{
+    PriorityTaskQueue tq {0ms};
+    std::string order;
+
+    tq.post([&order] { order += "low "; }, {.priority = Priority::low});
+    std::this_thread::sleep_for(2ms);
+    tq.post([&order] { order += "high "; }, {.priority = Priority::high});
+
+    tq.run();
+    REQUIRE(order == "high low ");
+}
+
+TEST_CASE("PriorityTaskQueue - queueing delay per priority")
+{
+    PriorityTaskQueue tq;
+
+    for (int i = 0; i < 3; ++i)
+        tq.post([] {}, {.priority = Priority::low});
+    tq.post([] { std::this_thread::sleep_for(2ms); }, {.priority = Priority::high});
+
+    tq.run();
+
+    const QueueingDelayStats& high = tq.queueing_delay(Priority::high);
+    const QueueingDelayStats& low = tq.queueing_delay(Priority::low);
+
+    REQUIRE(high.count == 1);
+    REQUIRE(low.count == 3);
+    REQUIRE(tq.queueing_delay(Priority::normal).count == 0);
+    REQUIRE(low.max >= 2ms); // waited for high priority task
+    REQUIRE(low.mean() <= low.max);
+}
+
+TEST_CASE("PriorityTaskQueue::submit - returns future")
+{
+    PriorityTaskQueue tq;
+
+    Future<int> low = tq.submit({.priority = Priority::low}, [](int x) { return x; }, 1);
+    Future<int> high = tq.submit({.priority = Priority::high}, [&low] { return low.is_ready() ? -1 : 2; });
+    Future<int> normal = tq.submit([] { return 3; });
+
+    tq.run();
+
+    REQUIRE(high.get() == 2);
+    REQUIRE(low.get() + normal.get() == 4);
+}
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    void spin_for(Clock::duration duration)
+    {
+        const auto end = Clock::now() + duration;
+        while (Clock::now() < end)
+        {
+        }
+    }
+
+    // backlog of low priority tasks is kept constant (every low task posts its successor)
+    // every 10th low task posts high priority task - latency = from post() to its start
+    template <typename TTaskQueue, typename TPost>
+    std::vector<Clock::duration> high_priority_latencies(TTaskQueue& tq, TPost post)
+    {
+        const int backlog = 1'000;
+        const int low_tasks_count = 20'000;
+
+        std::vector<Clock::duration> latencies;
+        latencies.reserve(low_tasks_count / 10);
+        int low_tasks_left = low_tasks_count;
+
+        std::function<void()> low_task = [&] {
+            spin_for(2us);
+
+            if (low_tasks_left-- > 0)
+                post(tq, Priority::low, [&low_task] { low_task(); });
+
+            if (low_tasks_left % 10 == 0)
+            {
+                const auto posted = Clock::now();
+                post(tq, Priority::high, [&latencies, posted] { latencies.push_back(Clock::now() - posted); });
+            }
+        };
+
+        for (int i = 0; i < backlog; ++i)
+            post(tq, Priority::low, [&low_task] { low_task(); });
+
+        tq.run();
+
+        return latencies;
+    }
+
+    void print_percentiles(const std::string& name, std::vector<Clock::duration> latencies)
+    {
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&](int p) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(latencies[latencies.size() * p / 100]).count();
+        };
+
+        std::cout << name << " - high priority latency p50: " << percentile(50) << " ns, p99: " << percentile(99) << " ns\n";
+    }
+}
+
+TEST_CASE("PriorityTaskQueue - high priority latency under low priority load", "[.][benchmark]")
+{
+    TaskQueue fifo;
+    print_percentiles("TaskQueue (FIFO)", high_priority_latencies(fifo, [](TaskQueue& tq, Priority, auto task) { tq.post(std::move(task)); }));
+
+    PriorityTaskQueue prioritized;
+    print_percentiles("PriorityTaskQueue", high_priority_latencies(prioritized, [](PriorityTaskQueue& tq, Priority priority, auto task) {
+        tq.post(std::move(task), {.priority = priority});
+    }));
+
+    for (Priority priority : {Priority::high, Priority::low})
+    {
+        const QueueingDelayStats& stats = prioritized.queueing_delay(priority);
+        std::cout << "  " << (priority == Priority::high ? "high" : "low") << " - tasks: " << stats.count
+                  << ", mean delay: " << std::chrono::duration_cast<std::chrono::nanoseconds>(stats.mean()).count()
+                  << " ns, max delay: " << std::chrono::duration_cast<std::chrono::nanoseconds>(stats.max).count() << " ns\n";
+    }
+}
@@ -0,0 +1,206 @@
+#ifndef PRIORITY_TASK_QUEUE_HPP
+#define PRIORITY_TASK_QUEUE_HPP
+
+#include "dary_heap.hpp"
+#include "future.hpp"
+#include "inplace_task.hpp"
+#include "task_queue.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+enum class Priority : uint8_t
+{
+    high,
+    normal,
+    low
+};
+
+inline constexpr size_t priorities_count = 3;
+
+struct TaskOptions
+{
+    Priority priority = Priority::normal;
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+};
+
+// time from post() to start of task
+struct QueueingDelayStats
+{
+    size_t count {};
+    std::chrono::steady_clock::duration total {};
+    std::chrono::steady_clock::duration max {};
+
+    std::chrono::steady_clock::duration mean() const noexcept
+    {
+        return count ? total / static_cast<long>(count) : std::chrono::steady_clock::duration {};
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// BasicPriorityTaskQueue - tasks executed by run() on the calling thread in order of
+//                          priority class, then earliest deadline, then FIFO
+//                          task waiting longer than aging_threshold is promoted one class up
+//                          (per every threshold it waits) - low priority work is not starved
+
+template <typename TTask>
+class BasicPriorityTaskQueue
+{
+public:
+    using Task = TTask;
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr Clock::duration no_aging = Clock::duration::max();
+
+private:
+    // heap holds small keys only - tasks stay in slots_ while heap is reordered
+    struct Entry
+    {
+        Clock::time_point deadline;
+        uint64_t sequence;
+        uint32_t slot;
+        Priority priority;
+
+        bool operator<(const Entry& other) const noexcept
+        {
+            if (priority != other.priority)
+                return priority < other.priority;
+            if (deadline != other.deadline)
+                return deadline < other.deadline;
+            return sequence < other.sequence;
+        }
+    };
+
+    struct Slot
+    {
+        Task task;
+        Clock::time_point posted;
+        Priority priority; // class at post() - metrics & aging are based on it
+    };
+
+    DaryHeap<Entry, 4> heap_;
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_slots_;
+    uint64_t next_sequence_ {};
+
+    Clock::duration aging_threshold_;
+    Clock::time_point next_aging_ {};
+
+    std::array<QueueingDelayStats, priorities_count> delay_stats_ {};
+
+    uint32_t acquire_slot(Task&& task, Clock::time_point now, Priority priority)
+    {
+        if (free_slots_.empty())
+        {
+            slots_.push_back(Slot {std::move(task), now, priority});
+            return static_cast<uint32_t>(slots_.size() - 1);
+        }
+
+        const uint32_t index = free_slots_.back();
+        slots_[index] = Slot {std::move(task), now, priority};
+        free_slots_.pop_back();
+
+        return index;
+    }
+
+    void age(Clock::time_point now)
+    {
+        heap_.update_all([&](Entry& entry) {
+            const Slot& slot = slots_[entry.slot];
+            const Clock::rep promotions = (now - slot.posted) / aging_threshold_;
+            entry.priority = static_cast<Priority>(std::max<Clock::rep>(0, static_cast<Clock::rep>(slot.priority) - promotions));
+        });
+
+        next_aging_ = now + aging_threshold_ / 4;
+    }
+
+    void record_delay(Priority priority, Clock::duration delay) noexcept
+    {
+        QueueingDelayStats& stats = delay_stats_[static_cast<size_t>(priority)];
+        ++stats.count;
+        stats.total += delay;
+        stats.max = std::max(stats.max, delay);
+    }
+
+public:
+    // zero (or negative) threshold disables aging - same as no_aging
+    explicit BasicPriorityTaskQueue(Clock::duration aging_threshold = std::chrono::milliseconds {100})
+        : aging_threshold_ {aging_threshold > Clock::duration::zero() ? aging_threshold : no_aging}
+    {
+    }
+
+    size_t size() const noexcept
+    {
+        return heap_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return heap_.empty();
+    }
+
+    void post(Task t, TaskOptions options = {})
+    {
+        const Clock::time_point now = Clock::now();
+        const uint32_t slot = acquire_slot(std::move(t), now, options.priority);
+
+        try
+        {
+            heap_.push(Entry {options.deadline, next_sequence_++, slot, options.priority});
+        }
+        catch (...)
+        {
+            slots_[slot].task = nullptr;
+            free_slots_.push_back(slot);
+            throw;
+        }
+    }
+
+    template <typename F, typename... TArgs>
+    auto submit(TaskOptions options, F&& f, TArgs&&... args) -> Future<Detail::SubmitResult<F, TArgs...>>
+    {
+        Promise<Detail::SubmitResult<F, TArgs...>> promise;
+        auto result = promise.get_future();
+
+        post(Detail::make_promised_call<Task>(std::move(promise), std::forward<F>(f), std::forward<TArgs>(args)...), options);
+
+        return result;
+    }
+
+    template <typename F, typename... TArgs>
+    auto submit(F&& f, TArgs&&... args) -> Future<Detail::SubmitResult<F, TArgs...>>
+    {
+        return submit(TaskOptions {}, std::forward<F>(f), std::forward<TArgs>(args)...);
+    }
+
+    void run()
+    {
+        while (!heap_.empty())
+        {
+            const Clock::time_point now = Clock::now();
+            if (aging_threshold_ != no_aging && now >= next_aging_)
+                age(now);
+
+            const Entry entry = heap_.pop();
+            Slot& slot = slots_[entry.slot];
+            Task task = std::move(slot.task);
+            record_delay(slot.priority, now - slot.posted);
+            free_slots_.push_back(entry.slot);
+
+            task();
+        }
+    }
+
+    const QueueingDelayStats& queueing_delay(Priority priority) const noexcept
+    {
+        return delay_stats_[static_cast<size_t>(priority)];
+    }
+};
+
+using PriorityTaskQueue = BasicPriorityTaskQueue<InplaceTask<>>;
+
+#endif
@@ -0,0 +1,218 @@
+#include "catch.hpp"
+#include "alloc_stats.hpp"
+#include "task.hpp"
+#include "task_queue.hpp"
+#include "thread_pool.hpp"
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    CoTask<int> answer()
+    {
+        co_return 42;
+    }
+
+    CoTask<std::string> describe()
+    {
+        const int value = co_await answer();
+        co_return "answer: " + std::to_string(value);
+    }
+
+    CoTask<int> fail()
+    {
+        throw std::runtime_error("task failed");
+        co_return 0;
+    }
+
+    CoTask<> steps(TaskQueue& tq, std::vector<std::string>& log)
+    {
+        log.push_back("step 1");
+        co_await tq.schedule();
+        log.push_back("step 2");
+        co_await tq.schedule();
+        log.push_back("step 3");
+    }
+
+    CoTask<long> sum_of(int count)
+    {
+        long sum = 0;
+        for (int i = 0; i < count; ++i)
+            sum += co_await answer();
+        co_return sum;
+    }
+}
+
+TEST_CASE("CoTask - awaits nested tasks")
+{
+    REQUIRE(sync_wait(answer()) == 42);
+    REQUIRE(sync_wait(describe()) == "answer: 42");
+    REQUIRE(sync_wait(sum_of(10'000)) == 420'000); // symmetric transfer - no stack overflow
+}
+
+TEST_CASE("CoTask - is lazy")
+{
+    bool has_started = false;
+    auto job = [&has_started]() -> CoTask<> {
+        has_started = true;
+        co_return;
+    };
+
+    CoTask<> task = job();
+    REQUIRE_FALSE(has_started);
+
+    sync_wait(std::move(task));
+    REQUIRE(has_started);
+}
+
+TEST_CASE("CoTask - exception is rethrown by co_await")
+{
+    REQUIRE_THROWS_AS(sync_wait(fail()), std::runtime_error);
+
+    auto catcher = []() -> CoTask<std::string> {
+        try
+        {
+            co_await fail();
+        }
+        catch (const std::runtime_error& e)
+        {
+            co_return e.what();
+        }
+        co_return "no exception";
+    };
+
+    REQUIRE(sync_wait(catcher()) == "task failed");
+}
+
+TEST_CASE("TaskQueue::schedule - coroutine continues as task of queue")
+{
+    TaskQueue tq;
+    std::vector<std::string> log;
+
+    tq.post([&log] { log.push_back("posted task"); });
+    sync_wait(tq, steps(tq, log));
+
+    REQUIRE(log == std::vector<std::string> {"step 1", "posted task", "step 2", "step 3"});
+}
+
+TEST_CASE("ThreadPool::schedule - coroutine hops to worker thread")
+{
+    ThreadPool pool {2};
+
+    auto hop = [&pool]() -> CoTask<std::thread::id> {
+        co_await pool.schedule();
+        co_return std::this_thread::get_id();
+    };
+
+    const std::thread::id main_id = std::this_thread::get_id();
+    auto hop_many = [&]() -> CoTask<int> {
+        int on_workers = 0;
+        for (int i = 0; i < 100; ++i)
+            if (co_await hop() != main_id)
+                ++on_workers;
+        co_return on_workers;
+    };
+
+    const std::thread::id worker_id = sync_wait(hop());
+    const int hops_on_workers = sync_wait(hop_many());
+
+    REQUIRE(worker_id != main_id);
+    REQUIRE(hops_on_workers == 100);
+}
+
+TEST_CASE("sync_wait(executor) - task completes on other thread")
+{
+    TaskQueue tq;
+    ThreadPool pool {2};
+
+    auto hop_away = [&tq, &pool](int value) -> CoTask<int> {
+        co_await tq.schedule();
+        co_await pool.schedule(); // completes on worker while calling thread runs tq
+        co_return value;
+    };
+
+    int sum = 0;
+    for (int i = 0; i < 1'000; ++i)
+        sum += sync_wait(tq, hop_away(i));
+
+    REQUIRE(sum == 499'500);
+}
+
+TEST_CASE("TaskQueue::schedule - coroutine hops back from worker thread")
+{
+    TaskQueue tq;
+    ThreadPool pool {2};
+    const std::thread::id main_id = std::this_thread::get_id();
+
+    auto round_trip = [&tq, &pool, main_id](int value) -> CoTask<int> {
+        co_await pool.schedule();
+        co_await tq.schedule(); // posted by worker - continues on thread running tq
+        co_return std::this_thread::get_id() == main_id ? value : -1;
+    };
+
+    int sum = 0;
+    for (int i = 0; i < 1'000; ++i)
+        sum += sync_wait(tq, round_trip(i));
+
+    REQUIRE(sum == 499'500);
+}
+
+TEST_CASE("CoTask - frames are reused from FramePool")
+{
+    REQUIRE(sync_wait(sum_of(10)) == 420); // warm-up of frame cache
+
+    AllocStats::Scope alloc_scope;
+    const long sum = sync_wait(sum_of(1'000));
+    const size_t allocations = alloc_scope.allocations();
+
+    REQUIRE(sum == 42'000);
+    REQUIRE(allocations == 1); // frame of sync_wait helper only
+}
+
+namespace
+{
+    CoTask<> hop_loop(TaskQueue& tq, int hops)
+    {
+        for (int i = 0; i < hops; ++i)
+            co_await tq.schedule();
+    }
+
+    // hand-written continuation - every step posts the next one
+    struct LambdaChain
+    {
+        TaskQueue& tq;
+        int hops_left;
+
+        void step()
+        {
+            if (hops_left-- > 0)
+                tq.post([this] { step(); });
+        }
+    };
+}
+
+TEST_CASE("CoTask - context switch vs. continuation lambdas", "[.][benchmark]")
+{
+    const int hops = 10'000;
+    TaskQueue tq;
+
+    BENCHMARK("co_await tq.schedule()")
+    {
+        sync_wait(tq, hop_loop(tq, hops));
+    };
+
+    BENCHMARK("tq.post(continuation lambda)")
+    {
+        LambdaChain chain {tq, hops};
+        chain.step();
+        tq.run();
+        return chain.hops_left;
+    };
+
+    BENCHMARK("co_await child CoTask<int> x 10000")
+    {
+        return sync_wait(sum_of(hops));
+    };
+}
@@ -0,0 +1,516 @@
+#ifndef TASK_HPP
+#define TASK_HPP
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace Detail
+{
+    ////////////////////////////////////////////////////////////////////////////
+    // FramePool - per-thread free lists of coroutine frames (size classes of 64 bytes up to 1 KiB)
+    //             frame freed on other thread (after hop) is cached by that thread,
+    //             every list is capped - surplus frames go back to ::operator delete
+
+    class FramePool
+    {
+        static constexpr size_t granularity = 64;
+        static constexpr size_t classes_count = 16;
+        static constexpr size_t max_cached_per_class = 256;
+
+        struct FreeFrame
+        {
+            FreeFrame* next;
+        };
+
+        struct FreeList
+        {
+            FreeFrame* head {};
+            size_t count {};
+        };
+
+        struct Cache
+        {
+            std::array<FreeList, classes_count> lists {};
+
+            ~Cache()
+            {
+                for (FreeList& list : lists)
+                    while (list.head)
+                        ::operator delete(std::exchange(list.head, list.head->next));
+            }
+        };
+
+        static Cache& cache() noexcept
+        {
+            static thread_local Cache cache;
+            return cache;
+        }
+
+        static size_t class_of(size_t size) noexcept
+        {
+            return (size + granularity - 1) / granularity - 1;
+        }
+
+    public:
+        static void* allocate(size_t size)
+        {
+            const size_t index = class_of(size);
+            if (index >= classes_count)
+                return ::operator new(size);
+
+            FreeList& list = cache().lists[index];
+            if (list.head)
+            {
+                --list.count;
+                return std::exchange(list.head, list.head->next);
+            }
+
+            return ::operator new((index + 1) * granularity);
+        }
+
+        static void deallocate(void* frame, size_t size) noexcept
+        {
+            const size_t index = class_of(size);
+            if (index >= classes_count)
+                return ::operator delete(frame);
+
+            FreeList& list = cache().lists[index];
+            if (list.count == max_cached_per_class)
+                return ::operator delete(frame);
+
+            list.head = new (frame) FreeFrame {list.head};
+            ++list.count;
+        }
+    };
+
+    // frames of coroutines with this promise base are allocated from FramePool
+    struct PooledFrame
+    {
+        static void* operator new(size_t size)
+        {
+            return FramePool::allocate(size);
+        }
+
+        static void operator delete(void* frame, size_t size) noexcept
+        {
+            FramePool::deallocate(frame, size);
+        }
+    };
+}
+
+template <typename T = void>
+class CoTask;
+
+namespace Detail
+{
+    struct TaskPromiseBase : PooledFrame
+    {
+        std::coroutine_handle<> continuation_;
+
+        // resumes awaiting coroutine (symmetric transfer - no stack growth in long chains)
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            template <typename TPromise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> h) noexcept
+            {
+                if (auto continuation = h.promise().continuation_)
+                    return continuation;
+                return std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+        };
+
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        FinalAwaiter final_suspend() const noexcept
+        {
+            return {};
+        }
+    };
+
+    template <typename T>
+    struct TaskPromise : TaskPromiseBase
+    {
+        std::variant<std::monostate, T, std::exception_ptr> result_;
+
+        CoTask<T> get_return_object() noexcept;
+
+        template <typename U>
+        void return_value(U&& value)
+        {
+            result_.template emplace<1>(std::forward<U>(value));
+        }
+
+        void unhandled_exception() noexcept
+        {
+            result_.template emplace<2>(std::current_exception());
+        }
+
+        T result()
+        {
+            if (result_.index() == 2)
+                std::rethrow_exception(std::get<2>(result_));
+
+            assert(result_.index() == 1);
+            return std::move(std::get<1>(result_));
+        }
+    };
+
+    template <>
+    struct TaskPromise<void> : TaskPromiseBase
+    {
+        std::exception_ptr exception_;
+
+        CoTask<void> get_return_object() noexcept;
+
+        void return_void() noexcept
+        {
+        }
+
+        void unhandled_exception() noexcept
+        {
+            exception_ = std::current_exception();
+        }
+
+        void result()
+        {
+            if (exception_)
+                std::rethrow_exception(exception_);
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////
+// CoTask<T> - lazy coroutine: starts when awaited (or by sync_wait), result is taken by co_await
+//           awaiting coroutine is resumed on the thread that completes the task
+//           frames come from Detail::FramePool
+
+template <typename T>
+class [[nodiscard]] CoTask
+{
+public:
+    using promise_type = Detail::TaskPromise<T>;
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+
+    struct Awaiter
+    {
+        std::coroutine_handle<promise_type> handle;
+
+        bool await_ready() const noexcept
+        {
+            return handle.done();
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            handle.promise().continuation_ = awaiting;
+            return handle;
+        }
+
+        T await_resume()
+        {
+            return handle.promise().result();
+        }
+    };
+
+public:
+    explicit CoTask(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_ {handle}
+    {
+    }
+
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+
+    CoTask(CoTask&& other) noexcept
+        : handle_ {std::exchange(other.handle_, nullptr)}
+    {
+    }
+
+    CoTask& operator=(CoTask&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle_)
+                handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+
+        return *this;
+    }
+
+    ~CoTask()
+    {
+        if (handle_)
+            handle_.destroy();
+    }
+
+    bool is_ready() const noexcept
+    {
+        return !handle_ || handle_.done();
+    }
+
+    Awaiter operator co_await() const& noexcept
+    {
+        assert(handle_);
+        return Awaiter {handle_};
+    }
+
+    Awaiter operator co_await() const&& noexcept
+    {
+        assert(handle_);
+        return Awaiter {handle_};
+    }
+};
+
+template <typename T>
+CoTask<T> Detail::TaskPromise<T>::get_return_object() noexcept
+{
+    return CoTask<T> {std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+
+inline CoTask<void> Detail::TaskPromise<void>::get_return_object() noexcept
+{
+    return CoTask<void> {std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+
+////////////////////////////////////////////////////////////////////////////
+// ScheduleAwaiter - co_await executor.schedule() resumes coroutine as task of executor
+//                   (on the thread that runs the executor)
+//                   executor with post_remote() (TaskQueue) is scheduled through it - coroutine may
+//                   await schedule() on a thread other than the one running the executor
+
+template <typename TExecutor>
+class ScheduleAwaiter
+{
+    TExecutor& executor_;
+
+public:
+    explicit ScheduleAwaiter(TExecutor& executor) noexcept
+        : executor_ {executor}
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> awaiting)
+    {
+        if constexpr (requires { executor_.post_remote([awaiting] { awaiting.resume(); }); })
+            executor_.post_remote([awaiting] { awaiting.resume(); });
+        else
+            executor_.post([awaiting] { awaiting.resume(); });
+    }
+
+    void await_resume() const noexcept
+    {
+    }
+};
+
+namespace Detail
+{
+    // signals waiting thread from final suspend point of awaited task
+    class SyncWaitEvent
+    {
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::atomic<bool> is_set_ {};
+        void (*on_set_)(void*) = nullptr;
+        void* on_set_context_ = nullptr;
+
+    public:
+        // on_set(context) is called by set() - wakes executor run by waiting thread
+        void set_on_set(void (*on_set)(void*), void* context) noexcept
+        {
+            on_set_ = on_set;
+            on_set_context_ = context;
+        }
+
+        void set()
+        {
+            // notified under lock - waiter cannot destroy event before notify_one() returns
+            std::lock_guard lk {mtx_};
+            is_set_.store(true, std::memory_order_release);
+            cv_.notify_one();
+            if (on_set_)
+                on_set_(on_set_context_);
+        }
+
+        // polled by thread running executor - wait() must follow before event is destroyed
+        bool is_set() const noexcept
+        {
+            return is_set_.load(std::memory_order_acquire);
+        }
+
+        void wait()
+        {
+            std::unique_lock lk {mtx_};
+            cv_.wait(lk, [this] { return is_set_.load(std::memory_order_relaxed); });
+        }
+
+        template <typename TDuration>
+        bool wait_for(TDuration timeout)
+        {
+            std::unique_lock lk {mtx_};
+            return cv_.wait_for(lk, timeout, [this] { return is_set_.load(std::memory_order_relaxed); });
+        }
+    };
+
+    struct SyncWaitTask
+    {
+        struct promise_type
+        {
+            SyncWaitEvent* event;
+
+            SyncWaitTask get_return_object() noexcept
+            {
+                return SyncWaitTask {std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            auto final_suspend() const noexcept
+            {
+                struct SetEvent
+                {
+                    bool await_ready() const noexcept
+                    {
+                        return false;
+                    }
+
+                    void await_suspend(std::coroutine_handle<promise_type> h) const noexcept
+                    {
+                        h.promise().event->set();
+                    }
+
+                    void await_resume() const noexcept
+                    {
+                    }
+                };
+
+                return SetEvent {};
+            }
+
+            void return_void() const noexcept
+            {
+            }
+
+            void unhandled_exception() const noexcept
+            {
+                std::terminate(); // result of awaited task is taken after sync_wait_task completes
+            }
+        };
+
+        std::coroutine_handle<promise_type> handle;
+
+        ~SyncWaitTask()
+        {
+            handle.destroy();
+        }
+    };
+
+    template <typename T>
+    SyncWaitTask sync_wait_task(const CoTask<T>& task)
+    {
+        struct IgnoreResult
+        {
+            const CoTask<T>& task;
+
+            bool await_ready() const noexcept
+            {
+                return task.is_ready();
+            }
+
+            auto await_suspend(std::coroutine_handle<> awaiting) const noexcept
+            {
+                return task.operator co_await().await_suspend(awaiting);
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+        };
+
+        co_await IgnoreResult {task};
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////
+// sync_wait - starts task & blocks calling thread until task completes (for tests & main())
+//             task may hop to executors run by other threads
+
+template <typename T>
+T sync_wait(CoTask<T> task)
+{
+    Detail::SyncWaitEvent event;
+    Detail::SyncWaitTask waiter = Detail::sync_wait_task(task);
+    waiter.handle.promise().event = &event;
+    waiter.handle.resume();
+    event.wait();
+
+    return task.operator co_await().await_resume();
+}
+
+// starts task & runs single-threaded executor (e.g. TaskQueue) on calling thread until task completes
+// while task waits on other thread (or timer) the calling thread blocks for up to idle_wait between runs
+// (executor with wait_for_remote() & wake() is woken as soon as task is posted to it or completes)
+template <typename TExecutor, typename T>
+T sync_wait(TExecutor& executor, CoTask<T> task, std::chrono::milliseconds idle_wait = std::chrono::milliseconds {1})
+{
+    constexpr bool is_wakeable = requires { executor.wait_for_remote(idle_wait); executor.wake(); };
+
+    Detail::SyncWaitEvent event;
+    if constexpr (is_wakeable)
+        event.set_on_set([](void* context) { static_cast<TExecutor*>(context)->wake(); }, &executor);
+
+    Detail::SyncWaitTask waiter = Detail::sync_wait_task(task);
+    waiter.handle.promise().event = &event;
+    waiter.handle.resume();
+
+    while (!event.is_set())
+    {
+        executor.run();
+        if (event.is_set())
+            break;
+
+        if constexpr (is_wakeable)
+            executor.wait_for_remote(idle_wait);
+        else
+            event.wait_for(idle_wait);
+    }
+
+    event.wait(); // completing thread has left set() - waiter & event may be destroyed
+
+    return task.operator co_await().await_resume();
+}
+
+#endif
@@ -0,0 +1,225 @@
+#include "catch.hpp"
+#include "task_metrics.hpp"
+#include "task_queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+using MeteredTaskQueue = BasicTaskQueue<InplaceTask<>, TaskMetrics::TaskQueueMetrics>;
+using UnmeteredTaskQueue = BasicTaskQueue<InplaceTask<>, TaskMetrics::NoMetrics>;
+
+TEST_CASE("LogHistogram - buckets")
+{
+    using TaskMetrics::LogHistogram;
+
+    size_t previous_bucket = 0;
+    for (uint64_t value = 0; value < 100'000; ++value)
+    {
+        const size_t bucket = LogHistogram::bucket_of(value);
+        const uint64_t upper_bound = LogHistogram::bucket_upper_bound(bucket);
+
+        REQUIRE(bucket >= previous_bucket);
+        REQUIRE(upper_bound >= value);
+        REQUIRE(upper_bound - value <= value / LogHistogram::sub_buckets);
+        previous_bucket = bucket;
+    }
+
+    REQUIRE(LogHistogram::bucket_of(UINT64_MAX) == LogHistogram::buckets_count - 1);
+    REQUIRE(LogHistogram::bucket_upper_bound(LogHistogram::buckets_count - 1) == UINT64_MAX);
+}
+
+TEST_CASE("LogHistogram - percentiles")
+{
+    TaskMetrics::LogHistogram histogram;
+    for (uint64_t value = 1; value <= 1'000; ++value)
+        histogram.record(value);
+
+    REQUIRE(histogram.count() == 1'000);
+    REQUIRE(histogram.max() == 1'000);
+    REQUIRE(histogram.mean() == Approx(500.5));
+    REQUIRE(histogram.percentile(0.5) == Approx(500).epsilon(0.125));
+    REQUIRE(histogram.percentile(0.99) == Approx(990).epsilon(0.125));
+    REQUIRE(histogram.percentile(1.0) == 1'000);
+
+    SECTION("merge")
+    {
+        TaskMetrics::LogHistogram other;
+        other.record(1'000'000);
+        histogram.merge(other);
+
+        REQUIRE(histogram.count() == 1'001);
+        REQUIRE(histogram.max() == 1'000'000);
+        REQUIRE(histogram.percentile(1.0) == 1'000'000);
+    }
+}
+
+TEST_CASE("TaskQueueMetrics - counters, histograms & slow tasks")
+{
+    MeteredTaskQueue tq {1ms};
+
+    for (int i = 0; i < 10; ++i)
+        tq.post([] {});
+    tq.post([] { std::this_thread::sleep_for(2ms); }, "sleeper");
+
+    TaskMetrics::Snapshot before_run = tq.metrics().snapshot();
+    REQUIRE(before_run.submitted == 11);
+    REQUIRE(before_run.depth() == 11);
+    REQUIRE(before_run.max_depth == 11);
+
+    tq.run();
+
+    TaskMetrics::Snapshot after_run = tq.metrics().snapshot();
+    REQUIRE(after_run.started == 11);
+    REQUIRE(after_run.completed == 11);
+    REQUIRE(after_run.depth() == 0);
+    REQUIRE(after_run.wait_time.count() == 11);
+    REQUIRE(after_run.run_time.count() == 11);
+    REQUIRE(after_run.run_time.max() >= 1ms);
+    REQUIRE(after_run.run_time.percentile(0.5) < 1ms);
+    REQUIRE(after_run.submit_rate(before_run) == 0.0);
+
+    REQUIRE(after_run.slow_tasks.size() == 1);
+    REQUIRE(after_run.slow_tasks[0].label == "sleeper"s);
+    REQUIRE(after_run.slow_tasks[0].run_time >= 1ms);
+}
+
+TEST_CASE("TaskQueueMetrics - per-thread shards merged by reader")
+{
+    const int threads_count = 4;
+    const int tasks_per_thread = 10'000;
+
+    TaskMetrics::TaskQueueMetrics metrics;
+    std::atomic<bool> is_done {};
+
+    uint64_t last_seen = 0;
+    bool is_monotonic = true;
+
+    // snapshots taken while shards are written
+    std::thread reader {[&] {
+        while (!is_done)
+        {
+            const uint64_t completed = metrics.snapshot().completed;
+            is_monotonic = is_monotonic && completed >= last_seen;
+            last_seen = completed;
+            std::this_thread::yield();
+        }
+    }};
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < threads_count; ++t)
+        writers.emplace_back([&metrics] {
+            for (int i = 0; i < tasks_per_thread; ++i)
+            {
+                const auto stamp = metrics.stamp(nullptr);
+                metrics.on_post(1);
+                const TaskMetrics::Ticks started = metrics.now();
+                metrics.on_start(stamp, started);
+                metrics.on_complete(stamp, started, metrics.now());
+            }
+        });
+
+    for (auto& writer : writers)
+        writer.join();
+    is_done = true;
+    reader.join();
+
+    REQUIRE(is_monotonic);
+
+    const TaskMetrics::Snapshot snapshot = metrics.snapshot();
+    REQUIRE(snapshot.submitted == threads_count * tasks_per_thread);
+    REQUIRE(snapshot.completed == threads_count * tasks_per_thread);
+    REQUIRE(snapshot.wait_time.count() == threads_count * tasks_per_thread);
+    REQUIRE(snapshot.max_depth == 1);
+}
+
+TEST_CASE("TaskQueue - metrics follow ENABLE_TASK_METRICS")
+{
+    static_assert(std::is_same_v<TaskQueue::Metrics, TaskMetrics::DefaultMetrics>);
+
+    TaskQueue tq;
+    for (int i = 0; i < 5; ++i)
+        tq.post([] {});
+    tq.run();
+
+    const TaskMetrics::Snapshot snapshot = tq.metrics().snapshot();
+    REQUIRE(snapshot.completed == (TaskMetrics::enabled ? 5u : 0u));
+
+    UnmeteredTaskQueue unmetered;
+    unmetered.post([] {});
+    unmetered.run();
+    REQUIRE(unmetered.metrics().snapshot().submitted == 0);
+}
+
+namespace
+{
+    template <typename TTaskQueue>
+    long long post_and_run(TTaskQueue& tq, int tasks_count)
+    {
+        long long sum = 0;
+        for (int i = 0; i < tasks_count; ++i)
+            tq.post([&sum, i] { sum += i; });
+        tq.run();
+        return sum;
+    }
+
+    template <typename TTaskQueue>
+    double nanoseconds_per_task(TTaskQueue& tq, int tasks_count)
+    {
+        double best = 1e9;
+        for (int attempt = 0; attempt < 20; ++attempt)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            REQUIRE(post_and_run(tq, tasks_count) > 0);
+            const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count() / tasks_count);
+        }
+        return best;
+    }
+}
+
+TEST_CASE("TaskQueueMetrics - overhead per task", "[.][benchmark]")
+{
+    const int tasks_count = 10'000;
+
+    UnmeteredTaskQueue unmetered;
+    MeteredTaskQueue metered;
+
+    const double unmetered_ns = nanoseconds_per_task(unmetered, tasks_count);
+    const double metered_ns = nanoseconds_per_task(metered, tasks_count);
+    const double timestamp_ns = [] {
+        const int count = 1'000'000;
+        TaskMetrics::Ticks sink = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; ++i)
+            sink += TaskMetrics::now();
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        REQUIRE(sink != 0);
+        return elapsed.count() / count;
+    }();
+
+    std::cout << "post + run - no metrics: " << unmetered_ns << " ns/task, metrics: " << metered_ns
+              << " ns/task, overhead: " << metered_ns - unmetered_ns << " ns/task (2 timestamps, " << timestamp_ns
+              << " ns each)\n";
+
+    const TaskMetrics::Snapshot snapshot = metered.metrics().snapshot();
+    std::cout << "tasks: " << snapshot.completed << ", max depth: " << snapshot.max_depth
+              << ", wait p50/p99: " << snapshot.wait_time.percentile(0.5).count() << "/" << snapshot.wait_time.percentile(0.99).count()
+              << " ns, run p50/p99: " << snapshot.run_time.percentile(0.5).count() << "/" << snapshot.run_time.percentile(0.99).count()
+              << " ns\n";
+
+    BENCHMARK("TaskQueue - NoMetrics")
+    {
+        return post_and_run(unmetered, tasks_count);
+    };
+
+    BENCHMARK("TaskQueue - TaskQueueMetrics")
+    {
+        return post_and_run(metered, tasks_count);
+    };
+}
@@ -0,0 +1,528 @@
+#ifndef TASK_METRICS_HPP
+#define TASK_METRICS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+// TaskMetrics - counters & latency histograms of task queues
+//               (enabled with ENABLE_TASK_METRICS, off by default - otherwise TaskQueue uses NoMetrics
+//                & all recording is compiled out)
+
+namespace TaskMetrics
+{
+#ifdef ENABLE_TASK_METRICS
+    constexpr bool enabled = true;
+#else
+    constexpr bool enabled = false;
+#endif
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Ticks - cheap timestamp (TSC on x86, steady_clock elsewhere)
+    //         converted to nanoseconds only by reader
+
+    using Ticks = uint64_t;
+
+    inline Ticks now() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        return __rdtsc();
+#else
+        return static_cast<Ticks>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    // measured once (busy-waits ~2ms on the first call)
+    inline double nanoseconds_per_tick()
+    {
+        static const double result = [] {
+            using Clock = std::chrono::steady_clock;
+
+            const auto start_time = Clock::now();
+            const Ticks start_ticks = now();
+            while (Clock::now() - start_time < std::chrono::milliseconds {2})
+            {
+            }
+            const Ticks end_ticks = now();
+            const auto end_time = Clock::now();
+
+            return std::chrono::duration<double, std::nano> {end_time - start_time}.count()
+                / static_cast<double>(std::max<Ticks>(1, end_ticks - start_ticks));
+        }();
+
+        return result;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // SingleWriterCounter - written by one thread, read by any thread
+    //                       (no lock-prefixed instructions on the hot path)
+
+    class SingleWriterCounter
+    {
+        std::atomic<uint64_t> value_ {};
+
+    public:
+        void add(uint64_t n) noexcept
+        {
+            value_.store(value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        void update_max(uint64_t value) noexcept
+        {
+            if (value > value_.load(std::memory_order_relaxed))
+                value_.store(value, std::memory_order_relaxed);
+        }
+
+        uint64_t load() const noexcept
+        {
+            return value_.load(std::memory_order_relaxed);
+        }
+    };
+
+    namespace Detail
+    {
+        inline void add(uint64_t& counter, uint64_t n) noexcept
+        {
+            counter += n;
+        }
+
+        inline void add(SingleWriterCounter& counter, uint64_t n) noexcept
+        {
+            counter.add(n);
+        }
+
+        inline void update_max(uint64_t& counter, uint64_t value) noexcept
+        {
+            counter = std::max(counter, value);
+        }
+
+        inline void update_max(SingleWriterCounter& counter, uint64_t value) noexcept
+        {
+            counter.update_max(value);
+        }
+
+        inline uint64_t load(uint64_t counter) noexcept
+        {
+            return counter;
+        }
+
+        inline uint64_t load(const SingleWriterCounter& counter) noexcept
+        {
+            return counter.load();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // BasicLogHistogram - HDR-style histogram: every power of two is split into
+    //                     sub_buckets linear buckets (relative error <= 1/sub_buckets)
+    //                     covers whole uint64_t range in fixed memory, record() is O(1)
+
+    template <typename TCounter>
+    class BasicLogHistogram
+    {
+        template <typename U>
+        friend class BasicLogHistogram;
+
+    public:
+        static constexpr unsigned sub_bucket_bits = 3;
+        static constexpr size_t sub_buckets = size_t {1} << sub_bucket_bits;
+        static constexpr size_t buckets_count = (64 - sub_bucket_bits + 1) * sub_buckets;
+
+        static size_t bucket_of(uint64_t value) noexcept
+        {
+            if (value < sub_buckets)
+                return static_cast<size_t>(value);
+
+            const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - 1 - sub_bucket_bits;
+            return (shift + 1) * sub_buckets + static_cast<size_t>((value >> shift) & (sub_buckets - 1));
+        }
+
+        // the largest value stored in bucket
+        static uint64_t bucket_upper_bound(size_t index) noexcept
+        {
+            if (index < sub_buckets)
+                return index;
+
+            const size_t shift = index / sub_buckets - 1;
+            const uint64_t lower = static_cast<uint64_t>(sub_buckets + index % sub_buckets) << shift;
+            return lower + ((uint64_t {1} << shift) - 1);
+        }
+
+    private:
+        std::array<TCounter, buckets_count> counts_ {};
+        TCounter sum_ {};
+        TCounter max_ {};
+
+    public:
+        void record(uint64_t value) noexcept
+        {
+            Detail::add(counts_[bucket_of(value)], 1);
+            Detail::add(sum_, value);
+            Detail::update_max(max_, value);
+        }
+
+        template <typename U>
+        void merge(const BasicLogHistogram<U>& other) noexcept
+        {
+            for (size_t i = 0; i < buckets_count; ++i)
+                Detail::add(counts_[i], Detail::load(other.counts_[i]));
+            Detail::add(sum_, Detail::load(other.sum_));
+            Detail::update_max(max_, Detail::load(other.max_));
+        }
+
+        // summed by reader - record() touches one counter less
+        uint64_t count() const noexcept
+        {
+            uint64_t result = 0;
+            for (const auto& counter : counts_)
+                result += Detail::load(counter);
+            return result;
+        }
+
+        uint64_t max() const noexcept
+        {
+            return Detail::load(max_);
+        }
+
+        double mean() const noexcept
+        {
+            const uint64_t count = this->count();
+            return count ? static_cast<double>(Detail::load(sum_)) / static_cast<double>(count) : 0.0;
+        }
+
+        // upper bound of bucket holding value at quantile q (0.0 - 1.0)
+        uint64_t percentile(double q) const noexcept
+        {
+            const uint64_t count = this->count();
+            if (count == 0)
+                return 0;
+
+            const auto rank = static_cast<uint64_t>(q * static_cast<double>(count - 1)) + 1;
+            uint64_t seen = 0;
+            for (size_t i = 0; i < buckets_count; ++i)
+            {
+                seen += Detail::load(counts_[i]);
+                if (seen >= rank)
+                    return std::min(bucket_upper_bound(i), max());
+            }
+
+            return max();
+        }
+    };
+
+    using LogHistogram = BasicLogHistogram<uint64_t>;
+
+    // histogram of ticks read as durations
+    struct DurationHistogram
+    {
+        LogHistogram ticks;
+        double nanoseconds_per_tick {1.0};
+
+        uint64_t count() const noexcept
+        {
+            return ticks.count();
+        }
+
+        std::chrono::nanoseconds percentile(double q) const noexcept
+        {
+            return to_duration(static_cast<double>(ticks.percentile(q)));
+        }
+
+        std::chrono::nanoseconds mean() const noexcept
+        {
+            return to_duration(ticks.mean());
+        }
+
+        std::chrono::nanoseconds max() const noexcept
+        {
+            return to_duration(static_cast<double>(ticks.max()));
+        }
+
+    private:
+        std::chrono::nanoseconds to_duration(double ticks_count) const noexcept
+        {
+            return std::chrono::nanoseconds {static_cast<std::chrono::nanoseconds::rep>(ticks_count * nanoseconds_per_tick)};
+        }
+    };
+
+    struct SlowTask
+    {
+        const char* label; // label passed to post() (nullptr if none)
+        std::chrono::nanoseconds wait_time;
+        std::chrono::nanoseconds run_time;
+    };
+
+    struct Snapshot
+    {
+        std::chrono::steady_clock::time_point taken_at {};
+        uint64_t submitted {};
+        uint64_t started {};
+        uint64_t completed {};
+        uint64_t max_depth {};
+        DurationHistogram wait_time; // from post() to start of task
+        DurationHistogram run_time;
+        std::vector<SlowTask> slow_tasks;
+
+        // tasks waiting in queue (approximate when recorded concurrently)
+        uint64_t depth() const noexcept
+        {
+            return submitted > started ? submitted - started : 0;
+        }
+
+        double submit_rate(const Snapshot& previous) const noexcept
+        {
+            const std::chrono::duration<double> elapsed = taken_at - previous.taken_at;
+            return elapsed.count() > 0 ? static_cast<double>(submitted - previous.submitted) / elapsed.count() : 0.0;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // NoMetrics - metrics policy of TaskQueue that records nothing
+
+    struct NoMetrics
+    {
+        struct Stamp
+        {
+        };
+
+        explicit NoMetrics(std::chrono::nanoseconds = {}) noexcept
+        {
+        }
+
+        Stamp stamp(const char*) const noexcept
+        {
+            return {};
+        }
+
+        Ticks now() const noexcept
+        {
+            return 0;
+        }
+
+        void on_post(size_t) noexcept
+        {
+        }
+
+        void on_start(const Stamp&, Ticks) noexcept
+        {
+        }
+
+        void on_complete(const Stamp&, Ticks, Ticks) noexcept
+        {
+        }
+
+        NoMetrics& recorder() noexcept
+        {
+            return *this;
+        }
+
+        // always empty
+        Snapshot snapshot() const
+        {
+            Snapshot result;
+            result.taken_at = std::chrono::steady_clock::now();
+            return result;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // TaskQueueMetrics - every recording thread writes into its own shard (no sharing of cache lines),
+    //                    snapshot() merges shards & may be called from any thread
+    //                    tasks running longer than slow_task_threshold are captured (last 16 per thread)
+
+    class TaskQueueMetrics
+    {
+    public:
+        struct Stamp
+        {
+            Ticks posted;
+            const char* label;
+        };
+
+        static constexpr size_t slow_tasks_per_shard = 16;
+
+    private:
+        struct alignas(64) Shard
+        {
+            std::thread::id owner;
+            SingleWriterCounter submitted;
+            SingleWriterCounter started;
+            SingleWriterCounter completed;
+            SingleWriterCounter max_depth;
+            BasicLogHistogram<SingleWriterCounter> wait_ticks;
+            BasicLogHistogram<SingleWriterCounter> run_ticks;
+
+            std::mutex slow_mtx; // taken only for slow tasks
+            std::array<SlowTask, slow_tasks_per_shard> slow_tasks {};
+            size_t slow_tasks_count {};
+        };
+
+        struct ThreadCache
+        {
+            uint64_t serial;
+            Shard* shard;
+        };
+
+        static inline std::atomic<uint64_t> next_serial_ {1};
+        static inline thread_local ThreadCache cache_ {}; // shard of the last used metrics
+
+        const uint64_t serial_ {next_serial_.fetch_add(1, std::memory_order_relaxed)};
+        const double nanoseconds_per_tick_ {TaskMetrics::nanoseconds_per_tick()};
+        const Ticks slow_task_ticks_;
+
+        mutable std::mutex shards_mtx_;
+        std::vector<std::unique_ptr<Shard>> shards_;
+
+        Shard& local_shard()
+        {
+            if (cache_.serial == serial_)
+                return *cache_.shard;
+
+            return local_shard_slow();
+        }
+
+        Shard& local_shard_slow()
+        {
+            std::lock_guard lk {shards_mtx_};
+
+            const std::thread::id this_thread = std::this_thread::get_id();
+            auto it = std::find_if(shards_.begin(), shards_.end(), [&](const auto& s) { return s->owner == this_thread; });
+            if (it == shards_.end())
+            {
+                shards_.push_back(std::make_unique<Shard>());
+                shards_.back()->owner = this_thread;
+                it = shards_.end() - 1;
+            }
+
+            cache_ = ThreadCache {serial_, it->get()};
+            return **it;
+        }
+
+        std::chrono::nanoseconds to_duration(Ticks ticks) const noexcept
+        {
+            return std::chrono::nanoseconds {static_cast<std::chrono::nanoseconds::rep>(static_cast<double>(ticks) * nanoseconds_per_tick_)};
+        }
+
+    public:
+        explicit TaskQueueMetrics(std::chrono::nanoseconds slow_task_threshold = std::chrono::milliseconds {1})
+            : slow_task_ticks_ {static_cast<Ticks>(static_cast<double>(slow_task_threshold.count()) / nanoseconds_per_tick_)}
+        {
+        }
+
+        TaskQueueMetrics(const TaskQueueMetrics&) = delete;
+        TaskQueueMetrics& operator=(const TaskQueueMetrics&) = delete;
+
+        Stamp stamp(const char* label) const noexcept
+        {
+            return Stamp {TaskMetrics::now(), label};
+        }
+
+        Ticks now() const noexcept
+        {
+            return TaskMetrics::now();
+        }
+
+        void on_post(size_t depth)
+        {
+            Shard& shard = local_shard();
+            shard.submitted.add(1);
+            shard.max_depth.update_max(depth);
+        }
+
+        // records start & completion of tasks into shard of the calling thread
+        //   looked up once per run() - not once per task
+        class Recorder
+        {
+            const TaskQueueMetrics& metrics_;
+            Shard& shard_;
+
+        public:
+            Recorder(const TaskQueueMetrics& metrics, Shard& shard) noexcept
+                : metrics_ {metrics}
+                , shard_ {shard}
+            {
+            }
+
+            void on_start(const Stamp& stamp, Ticks started) noexcept
+            {
+                shard_.started.add(1);
+                shard_.wait_ticks.record(started > stamp.posted ? started - stamp.posted : 0);
+            }
+
+            void on_complete(const Stamp& stamp, Ticks started, Ticks finished)
+            {
+                const Ticks run_ticks = finished > started ? finished - started : 0;
+                shard_.completed.add(1);
+                shard_.run_ticks.record(run_ticks);
+
+                if (run_ticks >= metrics_.slow_task_ticks_) [[unlikely]]
+                {
+                    std::lock_guard lk {shard_.slow_mtx};
+                    const Ticks wait_ticks = started > stamp.posted ? started - stamp.posted : 0;
+                    shard_.slow_tasks[shard_.slow_tasks_count++ % slow_tasks_per_shard]
+                        = SlowTask {stamp.label, metrics_.to_duration(wait_ticks), metrics_.to_duration(run_ticks)};
+                }
+            }
+        };
+
+        Recorder recorder()
+        {
+            return Recorder {*this, local_shard()};
+        }
+
+        void on_start(const Stamp& stamp, Ticks started)
+        {
+            recorder().on_start(stamp, started);
+        }
+
+        void on_complete(const Stamp& stamp, Ticks started, Ticks finished)
+        {
+            recorder().on_complete(stamp, started, finished);
+        }
+
+        Snapshot snapshot() const
+        {
+            Snapshot result;
+            result.taken_at = std::chrono::steady_clock::now();
+            result.wait_time.nanoseconds_per_tick = nanoseconds_per_tick_;
+            result.run_time.nanoseconds_per_tick = nanoseconds_per_tick_;
+
+            std::lock_guard lk {shards_mtx_};
+            for (const auto& shard : shards_)
+            {
+                result.submitted += shard->submitted.load();
+                result.started += shard->started.load();
+                result.completed += shard->completed.load();
+                result.max_depth = std::max(result.max_depth, shard->max_depth.load());
+                result.wait_time.ticks.merge(shard->wait_ticks);
+                result.run_time.ticks.merge(shard->run_ticks);
+
+                std::lock_guard slow_lk {shard->slow_mtx};
+                const size_t count = std::min(shard->slow_tasks_count, slow_tasks_per_shard);
+                result.slow_tasks.insert(result.slow_tasks.end(), shard->slow_tasks.begin(), shard->slow_tasks.begin() + count);
+            }
+
+            return result;
+        }
+    };
+
+    using DefaultMetrics = std::conditional_t<enabled, TaskQueueMetrics, NoMetrics>;
+}
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef TASK_QUEUE_HPP
+#define TASK_QUEUE_HPP
+
+#include "future.hpp"
+#include "inplace_task.hpp"
+#include "task.hpp"
+#include "task_metrics.hpp"
+#include "timer_wheel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+// BasicTaskQueue - FIFO of tasks executed by run() on the calling thread
+//                  post() - fire & forget void() task (no allocation with InplaceTask)
+//                  post_remote() - post() callable from any thread (tasks wait in locked inbox drained by run())
+//                  submit() - any callable, result is delivered through Future
+//                  submit_after() & submit_every() - delayed & periodic tasks (see timer_wheel.hpp)
+//                  TMetrics - records counters & latencies of tasks (see task_metrics.hpp)
+
+template <typename TTask, typename TMetrics = TaskMetrics::DefaultMetrics>
+class BasicTaskQueue
+{
+    struct Entry
+    {
+        TTask task;
+        [[no_unique_address]] typename TMetrics::Stamp stamp;
+    };
+
+    std::queue<Entry> tq_;
+    BasicTimerWheel<TTask> timers_;
+    TMetrics metrics_;
+
+    // tasks posted by other threads
+    std::mutex remote_mtx_;
+    std::condition_variable remote_cv_;
+    std::vector<Entry> remote_;
+    bool is_woken_ {};
+    std::atomic<bool> has_remote_ {};
+    std::atomic<std::thread::id> runner_ {}; // thread inside of run()
+
+    // moves tasks of other threads to the queue - returns false if there were none
+    bool drain_remote()
+    {
+        if (!has_remote_.load(std::memory_order_acquire))
+            return false;
+
+        std::lock_guard lk {remote_mtx_};
+        for (Entry& entry : remote_)
+            tq_.push(std::move(entry));
+        remote_.clear();
+        has_remote_.store(false, std::memory_order_relaxed);
+
+        return !tq_.empty();
+    }
+
+public:
+    using Task = TTask;
+    using Metrics = TMetrics;
+    using Clock = std::chrono::steady_clock;
+
+    // tasks running longer than slow_task_threshold are captured by metrics
+    explicit BasicTaskQueue(std::chrono::nanoseconds slow_task_threshold = std::chrono::milliseconds {1})
+        : metrics_ {slow_task_threshold}
+    {
+    }
+
+    // label is reported for slow task
+    void post(Task t, const char* label = nullptr)
+    {
+        tq_.push(Entry {std::move(t), metrics_.stamp(label)});
+        metrics_.on_post(tq_.size());
+    }
+
+    // thread-safe post() - task posted by thread running run() goes directly to the queue
+    void post_remote(Task t, const char* label = nullptr)
+    {
+        if (runner_.load(std::memory_order_relaxed) == std::this_thread::get_id())
+        {
+            post(std::move(t), label);
+            return;
+        }
+
+        size_t depth;
+        {
+            std::lock_guard lk {remote_mtx_};
+            remote_.push_back(Entry {std::move(t), metrics_.stamp(label)});
+            depth = remote_.size();
+            has_remote_.store(true, std::memory_order_release);
+            remote_cv_.notify_one();
+        }
+        metrics_.on_post(depth);
+    }
+
+    // ends wait_for_remote() without posting task
+    void wake()
+    {
+        std::lock_guard lk {remote_mtx_};
+        is_woken_ = true;
+        remote_cv_.notify_one();
+    }
+
+    // blocks until post_remote() or wake() is called by other thread (or timeout expires)
+    template <typename TDuration>
+    bool wait_for_remote(TDuration timeout)
+    {
+        std::unique_lock lk {remote_mtx_};
+        const bool is_signalled = remote_cv_.wait_for(lk, timeout, [this] { return is_woken_ || !remote_.empty(); });
+        is_woken_ = false;
+
+        return is_signalled;
+    }
+
+    // f & args are stored in task - exception thrown by f is passed to future
+    template <typename F, typename... TArgs>
+    auto submit(F&& f, TArgs&&... args) -> Future<Detail::SubmitResult<F, TArgs...>>
+    {
+        Promise<Detail::SubmitResult<F, TArgs...>> promise;
+        auto result = promise.get_future();
+
+        post(Detail::make_promised_call<Task>(std::move(promise), std::forward<F>(f), std::forward<TArgs>(args)...));
+
+        return result;
+    }
+
+    // task runs inline in the first run() after delay (at most one tick of timer wheel later)
+    TimerHandle submit_after(Clock::duration delay, Task t)
+    {
+        return timers_.submit_after(delay, std::move(t));
+    }
+
+    TimerHandle submit_at(Clock::time_point time_point, Task t)
+    {
+        return timers_.submit_at(time_point, std::move(t));
+    }
+
+    // task runs every period until cancelled (also from inside the task)
+    TimerHandle submit_every(Clock::duration period, Task t)
+    {
+        return timers_.submit_every(period, std::move(t));
+    }
+
+    // returns false if timer has already fired or was cancelled
+    bool cancel(TimerHandle timer)
+    {
+        return timers_.cancel(timer);
+    }
+
+    // co_await tq.schedule() - coroutine continues as task of this queue (on the thread running run())
+    //                         may be awaited on any thread - continuation is posted with post_remote()
+    ScheduleAwaiter<BasicTaskQueue> schedule() noexcept
+    {
+        return ScheduleAwaiter<BasicTaskQueue> {*this};
+    }
+
+    // must not be called by two threads at the same time
+    void run()
+    {
+        struct RunnerScope
+        {
+            std::atomic<std::thread::id>& runner;
+
+            ~RunnerScope()
+            {
+                runner.store(std::thread::id {}, std::memory_order_relaxed);
+            }
+        } runner_scope {runner_};
+        runner_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+        if (!timers_.empty())
+            timers_.advance(Clock::now());
+
+        // end of one task is start of the next one - one timestamp per task
+        auto&& recorder = metrics_.recorder();
+        TaskMetrics::Ticks started = metrics_.now();
+
+        while (!tq_.empty() || drain_remote())
+        {
+            Entry entry = std::move(tq_.front());
+            tq_.pop();
+
+            recorder.on_start(entry.stamp, started);
+            entry.task();
+
+            const TaskMetrics::Ticks finished = metrics_.now();
+            recorder.on_complete(entry.stamp, started, finished);
+            started = finished;
+        }
+    }
+
+    // runs tasks & fires timers until deadline - sleeps (instead of spinning) until the next timer tick
+    void run_until(Clock::time_point deadline)
+    {
+        while (true)
+        {
+            run();
+
+            if (Clock::now() >= deadline)
+                return;
+
+            wait_for_remote(std::min(deadline, timers_.next_wakeup().value_or(deadline)) - Clock::now());
+        }
+    }
+
+    void run_for(Clock::duration duration)
+    {
+        run_until(Clock::now() + duration);
+    }
+
+    const TMetrics& metrics() const noexcept
+    {
+        return metrics_;
+    }
+};
+
+using TaskQueue = BasicTaskQueue<InplaceTask<>>;
+
+#endif
@@ -1,6 +1,7 @@
 #include "catch.hpp"
+#include "call.hpp"
+#include "task_queue.hpp"
 #include <iostream>
-#include <queue>
 #include <string>
 #include <vector>
 #include <set>
@@ -175,45 +176,15 @@ TEST_CASE("storing closures")
     REQUIRE(f(10) == 100);
 }
 
-class TaskQueue
-{
-    using Task = std::function<void()>;
-    std::queue<Task> tq_;
-
-public:
-    void submit(Task t)
-    {
-        tq_.push(std::move(t));
-    }
-
-    void run()
-    {
-        Task task;
-        while (!tq_.empty())
-        {
-            task = tq_.front();
-            tq_.pop();
-
-            task();
-        }
-    }
-};
-
-template <typename F, typename... TArgs>
-decltype(auto) call(F&& f, TArgs&&... args)
-{
-    return f(std::forward<TArgs>(args)...);
-}
-
 TEST_CASE("task queue")
 {
     TaskQueue tq;
 
     std::vector<int> vec;
 
-    tq.submit([] { std::cout << "Start\n"; });
-    tq.submit([&vec] { vec.push_back(42); });
-    tq.submit([] { std::cout << "Stop\n"; });
+    tq.post([] { std::cout << "Start\n"; });
+    tq.post([&vec] { vec.push_back(42); });
+    tq.post([] { std::cout << "Stop\n"; });
 
     tq.run();
     REQUIRE(vec[0] == 42);
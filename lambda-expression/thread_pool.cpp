@@ -0,0 +1,165 @@
+#include "catch.hpp"
+#include "thread_pool.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // spawns two subtasks per call - number of leaves with value 1 equals fib(n)
+    void fib_task(ThreadPool& pool, int n, std::atomic<long>& result)
+    {
+        if (n < 2)
+        {
+            result.fetch_add(n, std::memory_order_relaxed);
+            return;
+        }
+
+        pool.post([&pool, n, &result] { fib_task(pool, n - 1, result); });
+        pool.post([&pool, n, &result] { fib_task(pool, n - 2, result); });
+    }
+
+    long fib(int n)
+    {
+        return n < 2 ? n : fib(n - 1) + fib(n - 2);
+    }
+}
+
+TEST_CASE("ThreadPool - runs submitted tasks")
+{
+    ThreadPool pool {4};
+    REQUIRE(pool.size() == 4);
+
+    std::atomic<int> counter {};
+    for (int i = 0; i < 1000; ++i)
+        pool.post([&counter] { ++counter; });
+
+    pool.wait();
+    REQUIRE(counter == 1000);
+
+    SECTION("pool can be reused after wait()")
+    {
+        pool.post([&counter] { counter = 0; });
+        pool.wait();
+        REQUIRE(counter == 0);
+    }
+}
+
+TEST_CASE("ThreadPool - tasks submitted from tasks")
+{
+    ThreadPool pool {4};
+
+    std::atomic<long> result {};
+    pool.post([&pool, &result] { fib_task(pool, 20, result); });
+    pool.wait();
+
+    REQUIRE(result == fib(20));
+}
+
+TEST_CASE("ThreadPool - exception thrown by task is rethrown by wait()")
+{
+    ThreadPool pool {2};
+
+    pool.post([] { throw std::runtime_error("task failed"); });
+
+    REQUIRE_THROWS_AS(pool.wait(), std::runtime_error);
+    REQUIRE_NOTHROW(pool.wait());
+}
+
+TEST_CASE("ThreadPool::submit - returns future of result")
+{
+    ThreadPool pool {2};
+
+    Future<int> sum = pool.submit([](int a, int b) { return a + b; }, 40, 2);
+    Future<std::string> text = pool.submit([](std::string s) { return s + "!"; }, std::string {"Hello"});
+    Future<int> failed = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+
+    REQUIRE(sum.get() == 42);
+    REQUIRE(text.get() == "Hello!");
+    REQUIRE_THROWS_AS(failed.get(), std::runtime_error);
+    REQUIRE_NOTHROW(pool.wait()); // exception of submitted task is delivered only by its future
+}
+
+TEST_CASE("ThreadPool - destructor completes pending tasks")
+{
+    std::atomic<int> counter {};
+    {
+        ThreadPool pool {2};
+        for (int i = 0; i < 100; ++i)
+            pool.post([&counter] {
+                std::this_thread::sleep_for(std::chrono::microseconds(10));
+                ++counter;
+            });
+    }
+
+    REQUIRE(counter == 100);
+}
+
+namespace
+{
+    template <typename TFunction>
+    double measure_seconds(TFunction f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    // coarse task - independent chunk of arithmetic
+    long long compute(int seed)
+    {
+        long long x = seed;
+        for (int i = 0; i < 100'000; ++i)
+            x = x * 6364136223846793005LL + 1442695040888963407LL;
+        return x;
+    }
+}
+
+TEST_CASE("ThreadPool - scaling", "[.][benchmark]")
+{
+    const int fib_n = 25;
+    const int coarse_tasks_count = 2'000;
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    const double serial_fib = measure_seconds([] { REQUIRE(fib(fib_n) > 0); });
+    const double serial_coarse = measure_seconds([] {
+        long long sum = 0;
+        for (int i = 0; i < coarse_tasks_count; ++i)
+            sum += compute(i);
+        REQUIRE(sum != 0);
+    });
+
+    std::cout << "serial - fib(" << fib_n << "): " << serial_fib * 1000 << " ms, coarse tasks: " << serial_coarse * 1000 << " ms\n";
+    std::cout << "threads | fine-grained fib [ms] | coarse tasks [ms]\n";
+
+    // powers of two - last step uses all cores
+    std::vector<unsigned> threads_counts;
+    for (unsigned threads_count = 1; threads_count < max_threads; threads_count *= 2)
+        threads_counts.push_back(threads_count);
+    threads_counts.push_back(max_threads);
+
+    for (const unsigned threads_count : threads_counts)
+    {
+        ThreadPool pool {threads_count};
+
+        std::atomic<long> fib_result {};
+        const double fib_time = measure_seconds([&] {
+            pool.post([&] { fib_task(pool, fib_n, fib_result); });
+            pool.wait();
+        });
+
+        std::atomic<long long> coarse_sum {};
+        const double coarse_time = measure_seconds([&] {
+            for (int i = 0; i < coarse_tasks_count; ++i)
+                pool.post([&coarse_sum, i] { coarse_sum += compute(i); });
+            pool.wait();
+        });
+
+        std::cout << threads_count << " | " << fib_time * 1000 << " | " << coarse_time * 1000 << "\n";
+    }
+}
@@ -0,0 +1,305 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include "future.hpp"
+#include "inplace_task.hpp"
+#include "task.hpp"
+#include "work_stealing_deque.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+// ThreadPool - multi-threaded executor with the same post() & submit() as TaskQueue
+//              (exception of posted task is rethrown by wait(), of submitted task by its Future)
+//              every worker owns WorkStealingDeque - tasks submitted from inside of task
+//              go to the local deque, tasks submitted from outside go to shared injection queue
+//              idle worker steals from random victims, then spins for a while & parks
+
+class ThreadPool
+{
+public:
+    using Task = InplaceTask<>;
+
+private:
+    static constexpr int spins_before_parking = 64;
+
+    struct alignas(64) Worker
+    {
+        WorkStealingDeque<Task*> tasks;
+        std::thread thread;
+        uint64_t random_state;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    // tasks submitted from outside of pool
+    std::mutex injected_mtx_;
+    std::deque<Task*> injected_;
+    std::atomic<size_t> injected_count_ {};
+
+    // parking - epoch is bumped on every wake-up, so wake-up between check & wait is not lost
+    std::mutex park_mtx_;
+    std::condition_variable park_cv_;
+    std::atomic<int> sleepers_ {};
+    uint64_t wake_epoch_ {};
+    bool is_stopping_ {};
+
+    std::atomic<size_t> unfinished_ {};
+    std::mutex exception_mtx_;
+    std::exception_ptr first_exception_;
+
+    // worker of the calling thread
+    static inline thread_local const ThreadPool* current_pool_ {};
+    static inline thread_local Worker* current_worker_ {};
+
+    Task* pop_injected()
+    {
+        if (injected_count_.load(std::memory_order_acquire) == 0)
+            return nullptr;
+
+        std::lock_guard lk {injected_mtx_};
+        if (injected_.empty())
+            return nullptr;
+
+        Task* task = injected_.front();
+        injected_.pop_front();
+        injected_count_.fetch_sub(1, std::memory_order_relaxed);
+
+        return task;
+    }
+
+    Task* steal_from_random_victim(Worker& thief)
+    {
+        const size_t count = workers_.size();
+
+        // xorshift
+        uint64_t& x = thief.random_state;
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+
+        const size_t first = static_cast<size_t>(x % count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            Worker& victim = *workers_[(first + i) % count];
+            if (&victim == &thief)
+                continue;
+
+            if (auto task = victim.tasks.steal())
+                return *task;
+        }
+
+        return nullptr;
+    }
+
+    Task* find_task(Worker& worker)
+    {
+        if (auto task = worker.tasks.take())
+            return *task;
+
+        if (Task* task = pop_injected())
+            return task;
+
+        return steal_from_random_victim(worker);
+    }
+
+    bool has_visible_work() const noexcept
+    {
+        if (injected_count_.load(std::memory_order_seq_cst) != 0)
+            return true;
+
+        return std::any_of(workers_.begin(), workers_.end(), [](const auto& w) { return !w->tasks.empty(); });
+    }
+
+    void wake_one()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_seq_cst) == 0)
+            return;
+
+        {
+            std::lock_guard lk {park_mtx_};
+            ++wake_epoch_;
+        }
+        park_cv_.notify_one();
+    }
+
+    // returns false if pool is stopping
+    bool park()
+    {
+        std::unique_lock lk {park_mtx_};
+        const uint64_t epoch = wake_epoch_;
+        lk.unlock();
+
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+
+        if (has_visible_work())
+        {
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        lk.lock();
+        park_cv_.wait(lk, [&] { return wake_epoch_ != epoch || is_stopping_; });
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+
+        return !is_stopping_;
+    }
+
+    void run_task(Task* task)
+    {
+        try
+        {
+            (*task)();
+        }
+        catch (...)
+        {
+            std::lock_guard lk {exception_mtx_};
+            if (!first_exception_)
+                first_exception_ = std::current_exception();
+        }
+
+        delete task;
+        task_finished();
+    }
+
+    void task_finished() noexcept
+    {
+        if (unfinished_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            unfinished_.notify_all();
+    }
+
+    void worker_loop(Worker& worker)
+    {
+        current_pool_ = this;
+        current_worker_ = &worker;
+
+        int idle_spins = 0;
+        while (true)
+        {
+            if (Task* task = find_task(worker))
+            {
+                idle_spins = 0;
+                run_task(task);
+                continue;
+            }
+
+            if (++idle_spins < spins_before_parking)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            idle_spins = 0;
+            if (!park())
+                break;
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t threads_count = std::max(1u, std::thread::hardware_concurrency()))
+    {
+        workers_.reserve(threads_count);
+        for (size_t i = 0; i < threads_count; ++i)
+        {
+            workers_.push_back(std::make_unique<Worker>());
+            workers_.back()->random_state = 0x9E3779B97F4A7C15ull * (i + 1);
+        }
+
+        for (auto& worker : workers_)
+            worker->thread = std::thread {[this, &worker = *worker] { worker_loop(worker); }};
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // completes all submitted tasks before workers are stopped
+    ~ThreadPool()
+    {
+        while (size_t unfinished = unfinished_.load(std::memory_order_acquire))
+            unfinished_.wait(unfinished, std::memory_order_acquire);
+
+        {
+            std::lock_guard lk {park_mtx_};
+            is_stopping_ = true;
+        }
+        park_cv_.notify_all();
+
+        for (auto& worker : workers_)
+            worker->thread.join();
+    }
+
+    size_t size() const noexcept
+    {
+        return workers_.size();
+    }
+
+    // fire & forget void() task
+    void post(Task t)
+    {
+        auto task = std::make_unique<Task>(std::move(t));
+
+        // counted before task becomes visible to workers
+        unfinished_.fetch_add(1, std::memory_order_relaxed);
+
+        try
+        {
+            if (current_pool_ == this)
+                current_worker_->tasks.push(task.get());
+            else
+            {
+                std::lock_guard lk {injected_mtx_};
+                injected_.push_back(task.get());
+                injected_count_.fetch_add(1, std::memory_order_release);
+            }
+        }
+        catch (...)
+        {
+            task_finished();
+            throw;
+        }
+
+        task.release();
+        wake_one();
+    }
+
+    // f & args are stored in task - exception thrown by f is passed to future
+    template <typename F, typename... TArgs>
+    auto submit(F&& f, TArgs&&... args) -> Future<Detail::SubmitResult<F, TArgs...>>
+    {
+        Promise<Detail::SubmitResult<F, TArgs...>> promise;
+        auto result = promise.get_future();
+
+        post(Detail::make_promised_call<Task>(std::move(promise), std::forward<F>(f), std::forward<TArgs>(args)...));
+
+        return result;
+    }
+
+    // co_await pool.schedule() - coroutine continues on one of workers
+    ScheduleAwaiter<ThreadPool> schedule() noexcept
+    {
+        return ScheduleAwaiter<ThreadPool> {*this};
+    }
+
+    // blocks until all posted & submitted tasks (including tasks posted by tasks) are completed
+    // rethrows first exception thrown by posted task - must not be called from inside of task
+    void wait()
+    {
+        while (size_t unfinished = unfinished_.load(std::memory_order_acquire))
+            unfinished_.wait(unfinished, std::memory_order_acquire);
+
+        std::lock_guard lk {exception_mtx_};
+        if (first_exception_)
+            std::rethrow_exception(std::exchange(first_exception_, nullptr));
+    }
+};
+
+#endif
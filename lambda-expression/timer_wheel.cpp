@@ -0,0 +1,367 @@
+#include "catch.hpp"
+#include "inplace_task.hpp"
+#include "task_queue.hpp"
+#include "timer_wheel.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std::literals;
+
+namespace
+{
+    // time moves only when test says so
+    struct ManualClock
+    {
+        using duration = std::chrono::nanoseconds;
+        using rep = duration::rep;
+        using period = duration::period;
+        using time_point = std::chrono::time_point<ManualClock>;
+        static constexpr bool is_steady = true;
+
+        static inline time_point current {};
+
+        static time_point now() noexcept
+        {
+            return current;
+        }
+    };
+
+    using TimerWheel = BasicTimerWheel<InplaceTask<>, ManualClock>;
+
+    const ManualClock::time_point epoch {};
+}
+
+TEST_CASE("TimerWheel - fires timers in order of expiry, never early")
+{
+    ManualClock::current = epoch;
+    TimerWheel wheel {1ms, epoch};
+    std::vector<std::string> log;
+
+    wheel.submit_after(1s, [&log] { log.push_back("1s"); });
+    wheel.submit_after(150ms, [&log] { log.push_back("150ms"); });
+    wheel.submit_after(5min, [&log] { log.push_back("5min"); });
+    wheel.submit_after(500us, [&log] { log.push_back("500us"); });
+    REQUIRE(wheel.size() == 4);
+
+    REQUIRE(wheel.advance(epoch + 149ms) == 1);
+    REQUIRE(log == std::vector<std::string> {"500us"});
+
+    REQUIRE(wheel.advance(epoch + 150ms) == 1);
+    REQUIRE(wheel.advance(epoch + 999ms) == 0);
+    REQUIRE(wheel.advance(epoch + 1s) == 1);
+    REQUIRE(wheel.advance(epoch + 4min + 59s) == 0);
+    REQUIRE(wheel.advance(epoch + 5min) == 1);
+
+    REQUIRE(log == std::vector<std::string> {"500us", "150ms", "1s", "5min"});
+    REQUIRE(wheel.empty());
+}
+
+TEST_CASE("TimerWheel - every delay is exact across cascades of levels")
+{
+    ManualClock::current = epoch;
+    TimerWheel wheel {1ms, epoch};
+
+    std::vector<uint64_t> delays;
+    for (uint64_t delay = 1; delay < 300'000; delay = delay * 3 / 2 + 1)
+        delays.push_back(delay);
+    delays.push_back(TimerWheel::slots_per_level);
+    delays.push_back(TimerWheel::slots_per_level * TimerWheel::slots_per_level);
+    delays.push_back(20'000'000); // beyond the span of wheel (64^4 ticks)
+
+    std::vector<uint64_t> fired_at(delays.size());
+    for (size_t i = 0; i < delays.size(); ++i)
+        wheel.submit_at(epoch + std::chrono::milliseconds(delays[i]), [&fired_at, i] { fired_at[i] = ManualClock::current.time_since_epoch() / 1ms; });
+
+    // steps of irregular length - timers have to fire in the step that reaches their expiry
+    std::mt19937_64 rnd {42};
+    while (!wheel.empty())
+    {
+        ManualClock::current += std::chrono::milliseconds(std::uniform_int_distribution<int> {1, 3}(rnd));
+        wheel.advance(ManualClock::current);
+        if (wheel.size() == 1 && ManualClock::current < epoch + 19'000'000ms)
+            ManualClock::current = epoch + 19'000'000ms; // skips the empty part of the last delay
+    }
+
+    for (size_t i = 0; i < delays.size(); ++i)
+    {
+        INFO("delay: " << delays[i]);
+        REQUIRE(fired_at[i] >= delays[i]);
+        REQUIRE(fired_at[i] <= delays[i] + 2);
+    }
+}
+
+TEST_CASE("TimerWheel - cancel")
+{
+    ManualClock::current = epoch;
+    TimerWheel wheel {1ms, epoch};
+    int fired = 0;
+
+    const TimerHandle first = wheel.submit_after(10ms, [&fired] { ++fired; });
+    const TimerHandle second = wheel.submit_after(10ms, [&fired] { ++fired; });
+    const TimerHandle far = wheel.submit_after(1h, [&fired] { ++fired; });
+
+    REQUIRE(wheel.cancel(first));
+    REQUIRE_FALSE(wheel.cancel(first));
+    REQUIRE(wheel.cancel(far));
+    REQUIRE(wheel.size() == 1);
+
+    REQUIRE(wheel.advance(epoch + 10ms) == 1);
+    REQUIRE(fired == 1);
+    REQUIRE_FALSE(wheel.cancel(second)); // already fired
+
+    SECTION("handle of reused timer is stale")
+    {
+        const TimerHandle reused = wheel.submit_after(1ms, [] {});
+        REQUIRE(reused.index == second.index);
+        REQUIRE_FALSE(wheel.cancel(second));
+        REQUIRE(wheel.cancel(reused));
+    }
+}
+
+TEST_CASE("TimerWheel - task cancels timer due in the same tick")
+{
+    ManualClock::current = epoch;
+    BasicTimerWheel<std::function<void()>, ManualClock> wheel {1ms, epoch}; // empty std::function throws when called
+
+    int fired = 0;
+    int reused_fired = 0;
+    TimerHandle first {};
+    TimerHandle second {};
+
+    // whichever fires first cancels the other one & reuses its timer
+    first = wheel.submit_after(10ms, [&] {
+        ++fired;
+        REQUIRE(wheel.cancel(second));
+        wheel.submit_after(1ms, [&reused_fired] { ++reused_fired; });
+    });
+    second = wheel.submit_after(10ms, [&] {
+        ++fired;
+        REQUIRE(wheel.cancel(first));
+        wheel.submit_after(1ms, [&reused_fired] { ++reused_fired; });
+    });
+
+    REQUIRE(wheel.advance(epoch + 10ms) == 1);
+    REQUIRE(fired == 1);
+    REQUIRE(reused_fired == 0);
+    REQUIRE(wheel.size() == 1);
+
+    REQUIRE(wheel.advance(epoch + 11ms) == 1);
+    REQUIRE(reused_fired == 1);
+    REQUIRE(wheel.empty());
+}
+
+TEST_CASE("TimerWheel - idle wheel catches up with clock on submit")
+{
+    ManualClock::current = epoch;
+    TimerWheel wheel {1ms, epoch};
+    int fired = 0;
+
+    ManualClock::current = epoch + 1h;
+    wheel.submit_after(1ms, [&fired] { ++fired; });
+
+    REQUIRE(wheel.next_wakeup() == epoch + 1h + 1ms);
+    REQUIRE(wheel.advance(epoch + 1h + 1ms) == 1);
+    REQUIRE(fired == 1);
+}
+
+TEST_CASE("TimerWheel - periodic timers")
+{
+    ManualClock::current = epoch;
+    TimerWheel wheel {1ms, epoch};
+
+    int ticks = 0;
+    const TimerHandle periodic = wheel.submit_every(150ms, [&ticks] { ++ticks; });
+
+    REQUIRE(wheel.advance(epoch + 149ms) == 0);
+    REQUIRE(wheel.advance(epoch + 150ms) == 1);
+    REQUIRE(wheel.advance(epoch + 1s) == 5);
+    REQUIRE(ticks == 6);
+
+    SECTION("late advance catches up missed periods")
+    {
+        REQUIRE(wheel.advance(epoch + 2s) == 7);
+        REQUIRE(wheel.advance(epoch + 2s + 99ms) == 0);
+        REQUIRE(wheel.advance(epoch + 2s + 100ms) == 1);
+    }
+
+    SECTION("cancel from outside")
+    {
+        REQUIRE(wheel.cancel(periodic));
+        REQUIRE(wheel.advance(epoch + 10s) == 0);
+        REQUIRE(wheel.empty());
+    }
+
+    SECTION("cancel from inside the task")
+    {
+        TimerHandle self {};
+        int runs = 0;
+        self = wheel.submit_every(1s, [&] {
+            if (++runs == 3)
+                wheel.cancel(self);
+            wheel.submit_after(1ms, [] {}); // timers may be added while firing
+        });
+
+        wheel.advance(epoch + 1min);
+        REQUIRE(runs == 3);
+        REQUIRE(wheel.size() == 1); // the 150ms timer
+    }
+}
+
+TEST_CASE("TaskQueue - submit_after & submit_every")
+{
+    TaskQueue tq;
+    std::vector<std::string> log;
+
+    tq.submit_after(30ms, [&log] { log.push_back("after 30ms"); });
+    const TimerHandle cancelled = tq.submit_after(10ms, [&log] { log.push_back("cancelled"); });
+    tq.post([&log] { log.push_back("posted"); });
+
+    int ticks = 0;
+    TimerHandle periodic {};
+    periodic = tq.submit_every(5ms, [&] {
+        if (++ticks == 3)
+            tq.cancel(periodic);
+    });
+
+    REQUIRE(tq.cancel(cancelled));
+
+    const auto start = TaskQueue::Clock::now();
+    tq.run_for(50ms);
+    const auto elapsed = TaskQueue::Clock::now() - start;
+
+    REQUIRE(elapsed >= 50ms);
+    REQUIRE(log == std::vector<std::string> {"posted", "after 30ms"});
+    REQUIRE(ticks == 3);
+}
+
+namespace
+{
+    // baseline - ordered map of expiries, iterator is handle of timer
+    class MapTimers
+    {
+        std::multimap<uint64_t, InplaceTask<>> timers_;
+
+    public:
+        using Handle = std::multimap<uint64_t, InplaceTask<>>::iterator;
+
+        Handle submit_at(uint64_t expiry, InplaceTask<> task)
+        {
+            return timers_.emplace(expiry, std::move(task));
+        }
+
+        void cancel(Handle handle)
+        {
+            timers_.erase(handle);
+        }
+
+        size_t advance(uint64_t now)
+        {
+            size_t fired = 0;
+            while (!timers_.empty() && timers_.begin()->first <= now)
+            {
+                InplaceTask<> task = std::move(timers_.begin()->second);
+                timers_.erase(timers_.begin());
+                task();
+                ++fired;
+            }
+            return fired;
+        }
+    };
+
+    struct Phases
+    {
+        double submit_ms;
+        double cancel_ms;
+        double advance_ms;
+        size_t fired;
+    };
+
+    template <typename F>
+    double elapsed_ms(F&& f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli> {std::chrono::steady_clock::now() - start}.count();
+    }
+}
+
+TEST_CASE("TimerWheel - 1M pending timers with cancellations", "[.][benchmark]")
+{
+    const size_t timers_count = 1'000'000;
+    const uint64_t max_delay_ms = 60'000;
+    const uint64_t step_ms = 1;
+
+    for (const double cancel_ratio : {0.5, 0.9, 0.99})
+    {
+        std::mt19937_64 rnd {665};
+        std::vector<uint64_t> delays(timers_count);
+        for (uint64_t& delay : delays)
+            delay = std::uniform_int_distribution<uint64_t> {1, max_delay_ms}(rnd);
+
+        std::vector<size_t> to_cancel;
+        for (size_t i = 0; i < timers_count; ++i)
+            if (std::uniform_real_distribution<double> {}(rnd) < cancel_ratio)
+                to_cancel.push_back(i);
+        std::shuffle(to_cancel.begin(), to_cancel.end(), rnd);
+
+        size_t sum = 0;
+
+        Phases wheel_phases {};
+        {
+            TimerWheel wheel {1ms, epoch};
+            wheel.reserve(timers_count);
+            std::vector<TimerHandle> handles(timers_count);
+
+            wheel_phases.submit_ms = elapsed_ms([&] {
+                for (size_t i = 0; i < timers_count; ++i)
+                    handles[i] = wheel.submit_at(epoch + std::chrono::milliseconds(delays[i]), [&sum, i] { sum += i; });
+            });
+            wheel_phases.cancel_ms = elapsed_ms([&] {
+                for (size_t i : to_cancel)
+                    wheel.cancel(handles[i]);
+            });
+            wheel_phases.advance_ms = elapsed_ms([&] {
+                for (uint64_t now = 0; now <= max_delay_ms; now += step_ms)
+                    wheel_phases.fired += wheel.advance(epoch + std::chrono::milliseconds(now));
+            });
+        }
+
+        Phases map_phases {};
+        {
+            MapTimers timers;
+            std::vector<MapTimers::Handle> handles(timers_count);
+
+            map_phases.submit_ms = elapsed_ms([&] {
+                for (size_t i = 0; i < timers_count; ++i)
+                    handles[i] = timers.submit_at(delays[i], [&sum, i] { sum += i; });
+            });
+            map_phases.cancel_ms = elapsed_ms([&] {
+                for (size_t i : to_cancel)
+                    timers.cancel(handles[i]);
+            });
+            map_phases.advance_ms = elapsed_ms([&] {
+                for (uint64_t now = 0; now <= max_delay_ms; now += step_ms)
+                    map_phases.fired += timers.advance(now);
+            });
+        }
+
+        REQUIRE(wheel_phases.fired == timers_count - to_cancel.size());
+        REQUIRE(map_phases.fired == wheel_phases.fired);
+
+        auto print = [](const char* name, const Phases& phases) {
+            std::cout << "  " << name << " - submit: " << phases.submit_ms << " ms, cancel: " << phases.cancel_ms
+                      << " ms, advance 60s in 1ms steps: " << phases.advance_ms << " ms, total: "
+                      << phases.submit_ms + phases.cancel_ms + phases.advance_ms << " ms\n";
+        };
+
+        std::cout << timers_count << " timers, " << to_cancel.size() << " cancelled (" << cancel_ratio * 100 << "%):\n";
+        print("TimerWheel", wheel_phases);
+        print("std::multimap", map_phases);
+    }
+}
@@ -0,0 +1,366 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+// TimerHandle - identifies timer in TimerWheel (generation detects handles of fired/cancelled timers)
+
+struct TimerHandle
+{
+    uint32_t index;
+    uint32_t generation;
+
+    bool operator==(const TimerHandle&) const = default;
+};
+
+////////////////////////////////////////////////////////////////////////////
+// BasicTimerWheel - hierarchical timing wheel (Varghese & Lauck) - 4 levels of 64 slots
+//                   level k slot spans 64^k ticks, timers move to lower levels when their slot is reached
+//                   insert & cancel are O(1) (intrusive lists of timers indexed in one vector)
+//                   advance() fires due tasks inline, at most one tick late, never early
+
+template <typename TTask, typename TClock = std::chrono::steady_clock>
+class BasicTimerWheel
+{
+public:
+    using Task = TTask;
+    using Clock = TClock;
+
+    static constexpr unsigned slot_bits = 6;
+    static constexpr size_t slots_per_level = size_t {1} << slot_bits;
+    static constexpr size_t levels_count = 4;
+
+private:
+    static constexpr uint32_t nil = UINT32_MAX;
+    static constexpr uint16_t free_slot = UINT16_MAX;
+    static constexpr uint16_t firing_slot = UINT16_MAX - 1;
+    static constexpr uint16_t expiring_slot = levels_count * slots_per_level; // list of due timers being fired
+    static constexpr uint64_t slot_mask = slots_per_level - 1;
+    static constexpr uint64_t wheel_span = uint64_t {1} << (slot_bits * levels_count); // in ticks
+
+    struct Timer
+    {
+        Task task;
+        uint64_t expiry; // tick
+        uint64_t period; // in ticks - 0 for one-shot timer
+        uint32_t prev = nil;
+        uint32_t next = nil;
+        uint32_t generation = 0;
+        uint16_t slot = free_slot; // level * slots_per_level + slot index
+    };
+
+    std::vector<Timer> timers_;
+    std::vector<uint32_t> free_timers_;
+    std::array<uint32_t, levels_count * slots_per_level + 1> heads_; // + expiring_slot
+    std::array<uint64_t, levels_count> occupied_ {}; // bit per non-empty slot
+
+    typename Clock::duration tick_;
+    typename Clock::time_point start_;
+    uint64_t current_tick_ {};
+    size_t size_ {};
+
+    uint64_t tick_at(typename Clock::time_point time_point) const noexcept
+    {
+        return time_point > start_ ? static_cast<uint64_t>((time_point - start_) / tick_) : 0;
+    }
+
+    uint64_t ticks_of(typename Clock::duration duration) const noexcept
+    {
+        return std::max<uint64_t>(1, static_cast<uint64_t>((duration + tick_ - typename Clock::duration {1}) / tick_));
+    }
+
+    void link(uint32_t index, size_t slot) noexcept
+    {
+        Timer& timer = timers_[index];
+        timer.slot = static_cast<uint16_t>(slot);
+        timer.prev = nil;
+        timer.next = heads_[slot];
+
+        if (timer.next != nil)
+            timers_[timer.next].prev = index;
+        heads_[slot] = index;
+        occupied_[slot / slots_per_level] |= uint64_t {1} << (slot & slot_mask);
+    }
+
+    void unlink(uint32_t index) noexcept
+    {
+        Timer& timer = timers_[index];
+        const size_t slot = timer.slot;
+
+        if (timer.prev != nil)
+            timers_[timer.prev].next = timer.next;
+        else
+            heads_[slot] = timer.next;
+
+        if (timer.next != nil)
+            timers_[timer.next].prev = timer.prev;
+
+        if (heads_[slot] == nil && slot != expiring_slot)
+            occupied_[slot / slots_per_level] &= ~(uint64_t {1} << (slot & slot_mask));
+    }
+
+    // detaches whole list of slot
+    uint32_t take_slot(size_t slot) noexcept
+    {
+        occupied_[slot / slots_per_level] &= ~(uint64_t {1} << (slot & slot_mask));
+        return std::exchange(heads_[slot], nil);
+    }
+
+    // idle wheel jumps to now - advance() does not walk rotations missed while nothing was pending
+    void catch_up() noexcept
+    {
+        if (size_ == 0)
+            current_tick_ = std::max(current_tick_, tick_at(Clock::now()));
+    }
+
+    // level is chosen by distance to expiry - timers beyond the wheel wait in the farthest slot
+    void place(uint32_t index) noexcept
+    {
+        const uint64_t expiry = std::max(timers_[index].expiry, current_tick_);
+        const uint64_t delta = expiry - current_tick_;
+
+        const size_t level = delta == 0 ? 0 : std::min<size_t>(levels_count - 1, (std::bit_width(delta) - 1) / slot_bits);
+        const uint64_t slot_tick = delta < wheel_span ? expiry : current_tick_ + wheel_span - 1;
+
+        link(index, level * slots_per_level + ((slot_tick >> (slot_bits * level)) & slot_mask));
+    }
+
+    uint32_t acquire(Task&& task, uint64_t expiry, uint64_t period)
+    {
+        uint32_t index;
+        if (free_timers_.empty())
+        {
+            index = static_cast<uint32_t>(timers_.size());
+            timers_.push_back(Timer {std::move(task), expiry, period});
+        }
+        else
+        {
+            index = free_timers_.back();
+            free_timers_.pop_back();
+
+            Timer& timer = timers_[index];
+            timer.task = std::move(task);
+            timer.expiry = expiry;
+            timer.period = period;
+        }
+
+        ++size_;
+        return index;
+    }
+
+    void release(uint32_t index)
+    {
+        Timer& timer = timers_[index];
+        timer.task = nullptr;
+        timer.slot = free_slot;
+        ++timer.generation;
+        free_timers_.push_back(index);
+        --size_;
+    }
+
+    // when tick is multiple of 64^k, timers of current level k slot are moved down (higher levels first)
+    void cascade() noexcept
+    {
+        for (size_t level = levels_count - 1; level > 0; --level)
+        {
+            if (current_tick_ & ((uint64_t {1} << (slot_bits * level)) - 1))
+                continue;
+
+            const size_t slot = level * slots_per_level + ((current_tick_ >> (slot_bits * level)) & slot_mask);
+            uint32_t index = take_slot(slot);
+            while (index != nil)
+            {
+                const uint32_t next = timers_[index].next;
+                place(index);
+                index = next;
+            }
+        }
+    }
+
+    size_t expire_current_slot()
+    {
+        size_t fired = 0;
+
+        // due timers stay linked until fired - task may cancel timer due in the same tick
+        heads_[expiring_slot] = take_slot(current_tick_ & slot_mask);
+        for (uint32_t index = heads_[expiring_slot]; index != nil; index = timers_[index].next)
+            timers_[index].slot = expiring_slot;
+
+        while (heads_[expiring_slot] != nil)
+        {
+            const uint32_t index = heads_[expiring_slot];
+            assert(timers_[index].expiry <= current_tick_);
+            unlink(index);
+            fire(index);
+            ++fired;
+        }
+
+        return fired;
+    }
+
+    // task is moved out while it runs - it may add timers (timers_ may grow) or cancel itself
+    void fire(uint32_t index)
+    {
+        Timer& timer = timers_[index];
+        Task task = std::move(timer.task);
+
+        if (timer.period == 0)
+        {
+            release(index);
+            task();
+            return;
+        }
+
+        const uint32_t generation = timer.generation;
+        timer.slot = firing_slot;
+        task();
+
+        Timer& periodic = timers_[index];
+        if (periodic.generation != generation) // cancelled by task
+            return;
+
+        periodic.task = std::move(task);
+        periodic.expiry += periodic.period;
+        place(index);
+    }
+
+public:
+    explicit BasicTimerWheel(typename Clock::duration tick = std::chrono::milliseconds {1}, typename Clock::time_point start = Clock::now())
+        : tick_ {tick}
+        , start_ {start}
+    {
+        heads_.fill(nil);
+    }
+
+    BasicTimerWheel(const BasicTimerWheel&) = delete;
+    BasicTimerWheel& operator=(const BasicTimerWheel&) = delete;
+
+    // number of pending timers
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    typename Clock::duration tick() const noexcept
+    {
+        return tick_;
+    }
+
+    void reserve(size_t capacity)
+    {
+        timers_.reserve(capacity);
+        free_timers_.reserve(capacity);
+    }
+
+    TimerHandle submit_at(typename Clock::time_point time_point, Task task)
+    {
+        catch_up();
+
+        const uint64_t expiry = std::max(current_tick_ + 1, tick_at(time_point) + ((time_point - start_) % tick_ != typename Clock::duration {} ? 1 : 0));
+        const uint32_t index = acquire(std::move(task), expiry, 0);
+        place(index);
+
+        return TimerHandle {index, timers_[index].generation};
+    }
+
+    TimerHandle submit_after(typename Clock::duration delay, Task task)
+    {
+        return submit_at(Clock::now() + delay, std::move(task));
+    }
+
+    // first run after one period, next runs every period (drift-free - late advance() catches up all periods)
+    TimerHandle submit_every(typename Clock::duration period, Task task)
+    {
+        catch_up();
+
+        const uint64_t period_ticks = ticks_of(period);
+        const uint64_t expiry = std::max(current_tick_, tick_at(Clock::now())) + period_ticks;
+        const uint32_t index = acquire(std::move(task), expiry, period_ticks);
+        place(index);
+
+        return TimerHandle {index, timers_[index].generation};
+    }
+
+    // returns false if timer has already fired (one-shot) or was cancelled
+    bool cancel(TimerHandle handle)
+    {
+        if (handle.index >= timers_.size())
+            return false;
+
+        Timer& timer = timers_[handle.index];
+        if (timer.generation != handle.generation || timer.slot == free_slot)
+            return false;
+
+        if (timer.slot != firing_slot)
+            unlink(handle.index);
+        release(handle.index);
+
+        return true;
+    }
+
+    // fires timers due until now - returns number of fired tasks
+    size_t advance(typename Clock::time_point now)
+    {
+        const uint64_t target = tick_at(now);
+        size_t fired = 0;
+
+        while (current_tick_ < target)
+        {
+            if (size_ == 0)
+            {
+                current_tick_ = target;
+                break;
+            }
+
+            // jumps to the next occupied slot of level 0 or to the end of rotation (cascade)
+            const uint64_t rotation = current_tick_ & ~slot_mask;
+            const uint64_t offset = current_tick_ & slot_mask;
+            const uint64_t later = offset == slot_mask ? 0 : occupied_[0] & (~uint64_t {0} << (offset + 1));
+            const uint64_t next = later ? rotation + static_cast<uint64_t>(std::countr_zero(later)) : rotation + slots_per_level;
+
+            if (next > target)
+            {
+                current_tick_ = target;
+                break;
+            }
+
+            current_tick_ = next;
+            if ((current_tick_ & slot_mask) == 0)
+                cascade();
+            fired += expire_current_slot();
+        }
+
+        return fired;
+    }
+
+    // time when advance() has work to do next (std::nullopt - no timers)
+    std::optional<typename Clock::time_point> next_wakeup() const noexcept
+    {
+        if (size_ == 0)
+            return std::nullopt;
+
+        const uint64_t rotation = current_tick_ & ~slot_mask;
+        const uint64_t offset = current_tick_ & slot_mask;
+        const uint64_t later = offset == slot_mask ? 0 : occupied_[0] & (~uint64_t {0} << (offset + 1));
+        const uint64_t next = later ? rotation + static_cast<uint64_t>(std::countr_zero(later)) : rotation + slots_per_level;
+
+        return start_ + tick_ * static_cast<typename Clock::rep>(next);
+    }
+};
+
+#endif
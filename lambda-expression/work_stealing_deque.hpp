@@ -0,0 +1,146 @@
+#ifndef WORK_STEALING_DEQUE_HPP
+#define WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+// WorkStealingDeque - Chase-Lev deque (Le, Pop, Cohen, Zappa Nardelli - PPoPP 2013)
+//                     owner thread push()es & take()s at the bottom (LIFO),
+//                     other threads steal() from the top (FIFO)
+//                     T must be trivially copyable (usually pointer to task)
+
+template <typename T>
+class WorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable_v<T>, "items are read racily by thieves");
+
+    class Buffer
+    {
+        const int64_t capacity_; // power of two
+        std::unique_ptr<std::atomic<T>[]> items_;
+
+    public:
+        explicit Buffer(int64_t capacity)
+            : capacity_ {capacity}
+            , items_ {new std::atomic<T>[static_cast<size_t>(capacity)]}
+        {
+        }
+
+        int64_t capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+        T get(int64_t index) const noexcept
+        {
+            return items_[index & (capacity_ - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, T item) noexcept
+        {
+            items_[index & (capacity_ - 1)].store(item, std::memory_order_relaxed);
+        }
+
+        std::unique_ptr<Buffer> grow(int64_t top, int64_t bottom) const
+        {
+            auto bigger = std::make_unique<Buffer>(2 * capacity_);
+            for (int64_t i = top; i != bottom; ++i)
+                bigger->put(i, get(i));
+            return bigger;
+        }
+    };
+
+    alignas(64) std::atomic<int64_t> top_ {0};
+    alignas(64) std::atomic<int64_t> bottom_ {0};
+    std::atomic<Buffer*> buffer_;
+    std::vector<std::unique_ptr<Buffer>> buffers_; // old buffers may still be read by thieves
+
+public:
+    explicit WorkStealingDeque(int64_t capacity = 256)
+    {
+        buffers_.push_back(std::make_unique<Buffer>(capacity));
+        buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // owner only
+    void push(T item)
+    {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+
+        if (bottom - top > buffer->capacity() - 1)
+        {
+            buffers_.push_back(buffer->grow(top, bottom));
+            buffer = buffers_.back().get();
+            buffer_.store(buffer, std::memory_order_release);
+        }
+
+        buffer->put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    // owner only - returns the most recently pushed item
+    std::optional<T> take()
+    {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) // empty
+        {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        std::optional<T> item = buffer->get(bottom);
+
+        if (top == bottom) // last item - race with thieves
+        {
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                item = std::nullopt;
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return item;
+    }
+
+    // any thread - returns the oldest item (std::nullopt if empty or lost race with other thread)
+    std::optional<T> steal()
+    {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+            return std::nullopt;
+
+        Buffer* buffer = buffer_.load(std::memory_order_acquire);
+        T item = buffer->get(top);
+
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return std::nullopt;
+
+        return item;
+    }
+
+    // approximate when called concurrently
+    bool empty() const noexcept
+    {
+        return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+    }
+};
+
+#endif
@@ -0,0 +1,82 @@
+#include "alloc_stats.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<size_t> allocations_count {};
+    std::atomic<size_t> allocated_bytes {};
+
+    constexpr size_t no_failure = static_cast<size_t>(-1);
+    thread_local size_t allocations_until_failure = no_failure;
+    thread_local bool has_failed_allocation = false;
+
+    void* counted_alloc(size_t size)
+    {
+        allocations_count.fetch_add(1, std::memory_order_relaxed);
+        allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+        if (allocations_until_failure != no_failure && allocations_until_failure-- == 0)
+        {
+            has_failed_allocation = true;
+            throw std::bad_alloc {};
+        }
+
+        if (void* ptr = std::malloc(size == 0 ? 1 : size))
+            return ptr;
+
+        throw std::bad_alloc {};
+    }
+}
+
+AllocStats::Snapshot AllocStats::snapshot() noexcept
+{
+    return Snapshot {allocations_count.load(std::memory_order_relaxed), allocated_bytes.load(std::memory_order_relaxed)};
+}
+
+AllocStats::FailingScope::FailingScope(size_t n) noexcept
+{
+    allocations_until_failure = n;
+    has_failed_allocation = false;
+}
+
+AllocStats::FailingScope::~FailingScope()
+{
+    allocations_until_failure = no_failure;
+}
+
+bool AllocStats::FailingScope::has_failed() const noexcept
+{
+    return has_failed_allocation;
+}
+
+void* operator new(size_t size)
+{
+    return counted_alloc(size);
+}
+
+void* operator new[](size_t size)
+{
+    return counted_alloc(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
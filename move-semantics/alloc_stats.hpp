@@ -0,0 +1,57 @@
+#ifndef ALLOC_STATS_HPP
+#define ALLOC_STATS_HPP
+
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////////////////
+// AllocStats - counts calls to global operator new (see alloc_stats.cpp)
+//              FailingScope injects std::bad_alloc for tests of exception safety
+
+namespace AllocStats
+{
+    struct Snapshot
+    {
+        size_t allocations;
+        size_t bytes;
+    };
+
+    Snapshot snapshot() noexcept;
+
+    // counts allocations made between construction and a call of allocations()/bytes()
+    class Scope
+    {
+        Snapshot start_;
+
+    public:
+        Scope() noexcept
+            : start_ {snapshot()}
+        {
+        }
+
+        size_t allocations() const noexcept
+        {
+            return snapshot().allocations - start_.allocations;
+        }
+
+        size_t bytes() const noexcept
+        {
+            return snapshot().bytes - start_.bytes;
+        }
+    };
+
+    // allocation number n (counted from 0) made by the calling thread in scope throws std::bad_alloc
+    class FailingScope
+    {
+    public:
+        explicit FailingScope(size_t n) noexcept;
+        ~FailingScope();
+
+        FailingScope(const FailingScope&) = delete;
+        FailingScope& operator=(const FailingScope&) = delete;
+
+        // false while fewer than n + 1 allocations were made in scope
+        bool has_failed() const noexcept;
+    };
+}
+
+#endif
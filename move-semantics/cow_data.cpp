@@ -0,0 +1,110 @@
+#include "catch.hpp"
+#include "cow_data.hpp"
+#include "data.hpp"
+#include <numeric>
+#include <thread>
+#include <vector>
+
+TEST_CASE("CowData - copy shares buffer")
+{
+    CowData ds1 {"ds1", {1, 2, 3, 4, 5}};
+
+    const CowData backup = ds1;
+
+    REQUIRE(ds1.use_count() == 2);
+    REQUIRE(backup.begin() == ds1.cbegin());
+
+    SECTION("first mutation detaches buffer")
+    {
+        *ds1.begin() = 42;
+
+        REQUIRE(ds1.use_count() == 1);
+        REQUIRE(backup.use_count() == 1);
+        REQUIRE(std::vector<int>(ds1.cbegin(), ds1.cend()) == std::vector<int> {42, 2, 3, 4, 5});
+        REQUIRE(std::vector<int>(backup.begin(), backup.end()) == std::vector<int> {1, 2, 3, 4, 5});
+    }
+
+    SECTION("unique buffer is not copied on mutation")
+    {
+        CowData target = std::move(ds1);
+        REQUIRE(target.use_count() == 2);
+        REQUIRE(ds1.use_count() == 0);
+        REQUIRE(ds1.begin() == ds1.end());
+
+        CowData other {"other", {6, 7}};
+        target = other;
+        REQUIRE(backup.use_count() == 1);
+
+        other = CowData {"temp", {8}};
+        const int* buffer = target.cbegin();
+        REQUIRE(target.begin() == buffer);
+    }
+}
+
+TEST_CASE("CowData - copy made after mutable access does not share buffer")
+{
+    CowData ds {"ds", {1, 2, 3}};
+    REQUIRE(ds.use_count() == 1);
+
+    CowData::iterator it = ds.begin(); // unique buffer - handed out without detaching
+    const CowData snapshot = ds;
+    *it = 42;
+
+    REQUIRE(ds.use_count() == 1);
+    REQUIRE(snapshot.use_count() == 1);
+    REQUIRE(std::vector<int>(ds.cbegin(), ds.cend()) == std::vector<int> {42, 2, 3});
+    REQUIRE(std::vector<int>(snapshot.begin(), snapshot.end()) == std::vector<int> {1, 2, 3});
+
+    const CowData shared = snapshot; // buffer of snapshot was never handed out
+    REQUIRE(shared.use_count() == 2);
+}
+
+TEST_CASE("CowData - concurrent read-only snapshots")
+{
+    const CowData ds {"ds", {1, 2, 53, 45, 645, 75647, 7561, 2, 3, 4, 5}};
+    const long long expected = std::accumulate(ds.begin(), ds.end(), 0LL);
+
+    std::vector<std::thread> threads;
+    std::vector<long long> sums(4);
+
+    for (auto& sum : sums)
+    {
+        threads.emplace_back([&ds, &sum] {
+            for (int i = 0; i < 10'000; ++i)
+            {
+                const CowData snapshot = ds;
+                sum += std::accumulate(snapshot.begin(), snapshot.end(), 0LL);
+            }
+        });
+    }
+
+    for (auto& thd : threads)
+        thd.join();
+
+    for (const auto& sum : sums)
+        REQUIRE(sum == 10'000 * expected);
+
+    REQUIRE(ds.use_count() == 1);
+}
+
+TEST_CASE("CowData - snapshot", "[.][benchmark]")
+{
+    Data data {"ds-large", {1, 2, 53, 45, 645, 75647, 7561, 2, 3, 4, 5}};
+    CowData cow_data {"ds-large", {1, 2, 53, 45, 645, 75647, 7561, 2, 3, 4, 5}};
+
+    BENCHMARK("Data - deep copy")
+    {
+        std::cout.setstate(std::ios::failbit); // silence Data traces
+        Data backup = data;
+        std::cout.clear();
+        return backup;
+    };
+
+    BENCHMARK("CowData - shared copy")
+    {
+        std::cout.setstate(std::ios::failbit);
+        CowData backup = cow_data;
+        std::cout.clear();
+        return backup;
+    };
+}
@@ -0,0 +1,191 @@
+#ifndef COW_DATA_HPP
+#define COW_DATA_HPP
+
+#include "instrumentation.hpp"
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <new>
+#include <string>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////
+// CowData - Data with copy-on-write buffer
+//           copies share buffer (atomic ref count), non-const begin()/end() detach it
+//           and mark it unshareable - mutable iterators may still write to it, so next copy gets own buffer
+
+class CowData
+{
+    struct Buffer
+    {
+        std::atomic<size_t> ref_count;
+        size_t size;
+        bool is_shareable = true; // changed only by the owner of unique buffer
+
+        int* items() noexcept
+        {
+            return reinterpret_cast<int*>(this + 1);
+        }
+
+        static Buffer* create(size_t size)
+        {
+            Instrumentation::record_allocation<CowData>(sizeof(Buffer) + size * sizeof(int));
+
+            void* raw_mem = ::operator new(sizeof(Buffer) + size * sizeof(int));
+            return new (raw_mem) Buffer {{1}, size};
+        }
+
+        static void release(Buffer* buffer) noexcept
+        {
+            if (buffer && buffer->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                buffer->~Buffer();
+                ::operator delete(buffer);
+            }
+        }
+    };
+
+    std::string name_;
+    Buffer* buffer_;
+
+    void detach()
+    {
+        if (buffer_ && buffer_->ref_count.load(std::memory_order_acquire) > 1)
+        {
+            Buffer* unique_buffer = Buffer::create(buffer_->size);
+            std::copy(cbegin(), cend(), unique_buffer->items());
+
+            Buffer::release(buffer_);
+            buffer_ = unique_buffer;
+        }
+    }
+
+    Buffer* share_buffer() const
+    {
+        if (!buffer_)
+            return nullptr;
+
+        if (!buffer_->is_shareable)
+        {
+            Buffer* copy = Buffer::create(buffer_->size);
+            std::copy(cbegin(), cend(), copy->items());
+            return copy;
+        }
+
+        buffer_->ref_count.fetch_add(1, std::memory_order_relaxed);
+        return buffer_;
+    }
+
+public:
+    using iterator = int*;
+    using const_iterator = const int*;
+
+    CowData(std::string name, std::initializer_list<int> list)
+        : name_ {std::move(name)}
+        , buffer_ {Buffer::create(list.size())}
+    {
+        std::copy(list.begin(), list.end(), buffer_->items());
+    }
+
+    // O(1) - buffer is shared (unless it was handed out by non-const begin())
+    CowData(const CowData& other)
+        : name_ {other.name_}
+        , buffer_ {other.share_buffer()}
+    {
+        Instrumentation::record<CowData>(Instrumentation::Event::copy_construction);
+    }
+
+    CowData& operator=(const CowData& other)
+    {
+        CowData temp(other);
+        swap(temp);
+
+        Instrumentation::record<CowData>(Instrumentation::Event::copy_assignment);
+
+        return *this;
+    }
+
+    CowData(CowData&& other) noexcept
+        : name_ {std::move(other.name_)}
+        , buffer_ {std::exchange(other.buffer_, nullptr)}
+    {
+        Instrumentation::record<CowData>(Instrumentation::Event::move_construction);
+    }
+
+    CowData& operator=(CowData&& other) noexcept
+    {
+        if (this != &other)
+        {
+            CowData temp(std::move(other));
+            swap(temp);
+        }
+
+        Instrumentation::record<CowData>(Instrumentation::Event::move_assignment);
+
+        return *this;
+    }
+
+    ~CowData() noexcept
+    {
+        Buffer::release(buffer_);
+    }
+
+    void swap(CowData& other) noexcept
+    {
+        name_.swap(other.name_);
+        std::swap(buffer_, other.buffer_);
+    }
+
+    const std::string& name() const noexcept
+    {
+        return name_;
+    }
+
+    size_t size() const noexcept
+    {
+        return buffer_ ? buffer_->size : 0;
+    }
+
+    // number of CowData objects sharing the buffer
+    size_t use_count() const noexcept
+    {
+        return buffer_ ? buffer_->ref_count.load(std::memory_order_relaxed) : 0;
+    }
+
+    iterator begin()
+    {
+        detach();
+        if (!buffer_)
+            return nullptr;
+
+        buffer_->is_shareable = false;
+        return buffer_->items();
+    }
+
+    iterator end()
+    {
+        return begin() + size();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return buffer_ ? buffer_->items() : nullptr;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return begin() + size();
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+};
+
+#endif
@@ -0,0 +1,285 @@
+#ifndef DATA_HPP
+#define DATA_HPP
+
+#include "instrumentation.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+// Data - class with copy & move semantics (user provided implementation)
+//        memory is obtained from std::pmr::memory_resource (default: new/delete)
+
+class Data
+{
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<int>;
+
+private:
+    allocator_type alloc_;
+    std::pmr::string name_;
+    int* data_;
+    size_t size_;
+
+    // copy or move made by assignment operator - recorded as assignment, not as construction
+    struct Unrecorded
+    {
+    };
+
+    Data(const Data& other, const allocator_type& alloc, Unrecorded)
+        : alloc_ {alloc}
+        , name_ {other.name_, alloc}
+        , data_ {alloc_.allocate(other.size_)}
+        , size_(other.size_)
+    {
+        std::copy(other.begin(), other.end(), data_);
+        Instrumentation::record_allocation<Data>(size_ * sizeof(int));
+
+        Trace::write("Data(", name_, ": cc)\n");
+    }
+
+    // steals buffer if other uses the same memory resource - copies otherwise
+    Data(Data&& other, const allocator_type& alloc, Unrecorded)
+        : alloc_ {alloc}
+        , name_ {std::move(other.name_), alloc}
+        , data_ {nullptr}
+        , size_ {other.size_}
+    {
+        if (alloc_ == other.alloc_)
+        {
+            data_ = other.data_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+
+            Trace::write("Data(", name_, ": mv)\n");
+        }
+        else
+        {
+            data_ = alloc_.allocate(size_);
+            std::copy(other.begin(), other.end(), data_);
+            Instrumentation::record_allocation<Data>(size_ * sizeof(int));
+
+            Trace::write("Data(", name_, ": cc)\n");
+        }
+    }
+
+public:
+    using iterator = int*;
+    using const_iterator = const int*;
+
+    Data(std::string_view name, std::initializer_list<int> list, const allocator_type& alloc = {})
+        : alloc_ {alloc}
+        , name_ {name, alloc}
+        , data_ {alloc_.allocate(list.size())}
+        , size_ {list.size()}
+    {
+        std::copy(list.begin(), list.end(), data_);
+        Instrumentation::record_allocation<Data>(size_ * sizeof(int));
+
+        Trace::write("Data(", name_, ")\n");
+    }
+
+    Data(const Data& other)
+        : Data(other, allocator_type {})
+    {
+    }
+
+    Data(const Data& other, const allocator_type& alloc)
+        : Data(other, alloc, Unrecorded {})
+    {
+        Instrumentation::record<Data>(Instrumentation::Event::copy_construction);
+    }
+
+    Data& operator=(const Data& other)
+    {
+        Instrumentation::record<Data>(Instrumentation::Event::copy_assignment);
+
+        Data temp(other, alloc_, Unrecorded {});
+        swap(temp);
+
+        Trace::write("Data=(", name_, ": cc)\n");
+
+        return *this;
+    }
+
+    /////////////////////////////////////////////////
+    // move constructor
+    Data(Data&& other) noexcept
+        : alloc_ {other.alloc_}
+        , name_ {std::move(other.name_)}
+        , data_ {other.data_}
+        , size_ {other.size_}
+    {
+        other.data_ = nullptr;
+        other.size_ = 0;
+        Instrumentation::record<Data>(Instrumentation::Event::move_construction);
+
+        Trace::write("Data(", name_, ": mv)\n");
+    }
+
+    // steals buffer if other uses the same memory resource - copies otherwise
+    Data(Data&& other, const allocator_type& alloc)
+        : Data(std::move(other), alloc, Unrecorded {})
+    {
+        const bool is_stolen = alloc_ == other.alloc_;
+        Instrumentation::record<Data>(is_stolen ? Instrumentation::Event::move_construction : Instrumentation::Event::copy_construction);
+    }
+
+    /////////////////////////////////////////////////
+    // move assignment
+    Data& operator=(Data&& other)
+    {
+        Instrumentation::record<Data>(Instrumentation::Event::move_assignment);
+
+        if (this != &other)
+        {
+            Data temp(std::move(other), alloc_, Unrecorded {});
+            swap(temp);
+        }
+
+        Trace::write("Data=(", name_, ": mv)\n");
+
+        return *this;
+    }
+
+    ~Data() noexcept
+    {
+        if (data_)
+            alloc_.deallocate(data_, size_);
+    }
+
+    // both objects must use the same memory resource
+    void swap(Data& other)
+    {
+        assert(alloc_ == other.alloc_);
+
+        name_.swap(other.name_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+
+    allocator_type get_allocator() const noexcept
+    {
+        return alloc_;
+    }
+
+    const std::pmr::string& name() const noexcept
+    {
+        return name_;
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    iterator begin() noexcept
+    {
+        return data_;
+    }
+
+    iterator end() noexcept
+    {
+        return data_ + size_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return data_;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return data_ + size_;
+    }
+};
+
+namespace ModernCpp
+{
+    class Data
+    {
+        std::pmr::string name_;
+        std::pmr::vector<int> data_;
+
+    public:
+        using iterator = std::pmr::vector<int>::iterator;
+        using const_iterator = std::pmr::vector<int>::const_iterator;
+        using allocator_type = std::pmr::polymorphic_allocator<int>;
+
+        Data(std::string_view name, std::initializer_list<int> list, const allocator_type& alloc = {})
+            : name_ {name, alloc}
+            , data_ {list, alloc}
+        {
+            Trace::write("Data(", name_, ")\n");
+        }
+
+        Data(const Data&) = default;
+        Data(Data&&) = default;
+        Data& operator=(const Data&) = default;
+        Data& operator=(Data&&) = default;
+
+        Data(const Data& other, const allocator_type& alloc)
+            : name_ {other.name_, alloc}
+            , data_ {other.data_, alloc}
+        {
+        }
+
+        // pmr containers steal within the same memory resource and copy otherwise
+        Data(Data&& other, const allocator_type& alloc)
+            : name_ {std::move(other.name_), alloc}
+            , data_ {std::move(other.data_), alloc}
+        {
+        }
+
+        void swap(Data& other)
+        {
+            name_.swap(other.name_);
+            data_.swap(other.data_);
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return data_.get_allocator();
+        }
+
+        const std::pmr::string& name() const noexcept
+        {
+            return name_;
+        }
+
+        size_t size() const noexcept
+        {
+            return data_.size();
+        }
+
+        iterator begin()
+        {
+            return data_.begin();
+        }
+
+        iterator end()
+        {
+            return data_.end();
+        }
+
+        const_iterator begin() const
+        {
+            return data_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return data_.end();
+        }
+    };
+
+}
+
+#endif
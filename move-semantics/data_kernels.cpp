@@ -0,0 +1,243 @@
+#include "data_kernels.hpp"
+#include <algorithm>
+#include <climits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DATA_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    namespace Scalar
+    {
+        long long sum(const int* first, const int* last)
+        {
+            long long result {};
+            for (; first != last; ++first)
+                result += *first;
+            return result;
+        }
+
+        DataKernels::MinMax minmax(const int* first, const int* last)
+        {
+            DataKernels::MinMax result {INT_MAX, INT_MIN};
+            for (; first != last; ++first)
+            {
+                result.min = std::min(result.min, *first);
+                result.max = std::max(result.max, *first);
+            }
+            return result;
+        }
+
+        size_t count_in_range(const int* first, const int* last, int low, int high)
+        {
+            size_t result {};
+            for (; first != last; ++first)
+                result += (low <= *first && *first <= high);
+            return result;
+        }
+
+        void scale_offset(int* first, int* last, int factor, int offset)
+        {
+            for (; first != last; ++first)
+                *first = static_cast<int>(static_cast<unsigned>(*first) * static_cast<unsigned>(factor) + static_cast<unsigned>(offset));
+        }
+    }
+
+#ifdef DATA_KERNELS_X86
+    namespace Sse41
+    {
+        constexpr size_t lanes = 4;
+
+        __attribute__((target("sse4.1"))) long long sum(const int* first, const int* last)
+        {
+            __m128i acc = _mm_setzero_si128();
+            for (; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes)
+            {
+                const __m128i items = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(items));
+                acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(_mm_srli_si128(items, 8)));
+            }
+
+            alignas(16) long long partial[2];
+            _mm_store_si128(reinterpret_cast<__m128i*>(partial), acc);
+
+            return partial[0] + partial[1] + Scalar::sum(first, last);
+        }
+
+        __attribute__((target("sse4.1"))) DataKernels::MinMax minmax(const int* first, const int* last)
+        {
+            __m128i min_acc = _mm_set1_epi32(INT_MAX);
+            __m128i max_acc = _mm_set1_epi32(INT_MIN);
+            for (; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes)
+            {
+                const __m128i items = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                min_acc = _mm_min_epi32(min_acc, items);
+                max_acc = _mm_max_epi32(max_acc, items);
+            }
+
+            alignas(16) int mins[lanes];
+            alignas(16) int maxs[lanes];
+            _mm_store_si128(reinterpret_cast<__m128i*>(mins), min_acc);
+            _mm_store_si128(reinterpret_cast<__m128i*>(maxs), max_acc);
+
+            DataKernels::MinMax result = Scalar::minmax(first, last);
+            result.min = std::min(result.min, *std::min_element(mins, mins + lanes));
+            result.max = std::max(result.max, *std::max_element(maxs, maxs + lanes));
+            return result;
+        }
+
+        __attribute__((target("sse4.1,popcnt"))) size_t count_in_range(const int* first, const int* last, int low, int high)
+        {
+            const __m128i lows = _mm_set1_epi32(low);
+            const __m128i highs = _mm_set1_epi32(high);
+
+            size_t result {};
+            for (; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes)
+            {
+                const __m128i items = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                const __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(lows, items), _mm_cmpgt_epi32(items, highs));
+                result += lanes - __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(outside)));
+            }
+
+            return result + Scalar::count_in_range(first, last, low, high);
+        }
+
+        __attribute__((target("sse4.1"))) void scale_offset(int* first, int* last, int factor, int offset)
+        {
+            const __m128i factors = _mm_set1_epi32(factor);
+            const __m128i offsets = _mm_set1_epi32(offset);
+            for (; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes)
+            {
+                const __m128i items = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(first), _mm_add_epi32(_mm_mullo_epi32(items, factors), offsets));
+            }
+
+            Scalar::scale_offset(first, last, factor, offset);
+        }
+    }
+
+    namespace Avx2
+    {
+        constexpr size_t lanes = 8;
+
+        __attribute__((target("avx2"))) long long sum(const int* first, const int* last)
+        {
+            __m256i acc = _mm256_setzero_si256();
+            for (; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes)
+            {
+                const __m256i items = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(items)));
+                acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(items, 1)));
+            }
+
+            alignas(32) long long partial[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(partial), acc);
+
+            return partial[0] + partial[1] + partial[2] + partial[3] + Scalar::sum(first, last);
+        }
+
+        __attribute__((target("avx2"))) DataKernels::MinMax minmax(const int* first, const int* last)
+        {
+            __m256i min_acc = _mm256_set1_epi32(INT_MAX);
+            __m256i max_acc = _mm256_set1_epi32(INT_MIN);
+            for (; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes)
+            {
+                const __m256i items = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                min_acc = _mm256_min_epi32(min_acc, items);
+                max_acc = _mm256_max_epi32(max_acc, items);
+            }
+
+            alignas(32) int mins[lanes];
+            alignas(32) int maxs[lanes];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(mins), min_acc);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(maxs), max_acc);
+
+            DataKernels::MinMax result = Scalar::minmax(first, last);
+            result.min = std::min(result.min, *std::min_element(mins, mins + lanes));
+            result.max = std::max(result.max, *std::max_element(maxs, maxs + lanes));
+            return result;
+        }
+
+        __attribute__((target("avx2,popcnt"))) size_t count_in_range(const int* first, const int* last, int low, int high)
+        {
+            const __m256i lows = _mm256_set1_epi32(low);
+            const __m256i highs = _mm256_set1_epi32(high);
+
+            size_t result {};
+            for (; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes)
+            {
+                const __m256i items = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                const __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(lows, items), _mm256_cmpgt_epi32(items, highs));
+                result += lanes - __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(outside)));
+            }
+
+            return result + Scalar::count_in_range(first, last, low, high);
+        }
+
+        __attribute__((target("avx2"))) void scale_offset(int* first, int* last, int factor, int offset)
+        {
+            const __m256i factors = _mm256_set1_epi32(factor);
+            const __m256i offsets = _mm256_set1_epi32(offset);
+            for (; last - first >= static_cast<ptrdiff_t>(lanes); first += lanes)
+            {
+                const __m256i items = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(first), _mm256_add_epi32(_mm256_mullo_epi32(items, factors), offsets));
+            }
+
+            Scalar::scale_offset(first, last, factor, offset);
+        }
+    }
+#endif
+
+    const DataKernels::KernelSet scalar_kernels {&Scalar::sum, &Scalar::minmax, &Scalar::count_in_range, &Scalar::scale_offset};
+
+#ifdef DATA_KERNELS_X86
+    const DataKernels::KernelSet sse41_kernels {&Sse41::sum, &Sse41::minmax, &Sse41::count_in_range, &Sse41::scale_offset};
+    const DataKernels::KernelSet avx2_kernels {&Avx2::sum, &Avx2::minmax, &Avx2::count_in_range, &Avx2::scale_offset};
+#endif
+}
+
+bool DataKernels::is_supported(Isa isa) noexcept
+{
+    switch (isa)
+    {
+#ifdef DATA_KERNELS_X86
+        case Isa::avx2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+        case Isa::sse41:
+            return __builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("popcnt");
+#endif
+        case Isa::scalar:
+            return true;
+        default:
+            return false;
+    }
+}
+
+DataKernels::Isa DataKernels::best_isa() noexcept
+{
+    for (Isa isa : {Isa::avx2, Isa::sse41})
+    {
+        if (is_supported(isa))
+            return isa;
+    }
+
+    return Isa::scalar;
+}
+
+const DataKernels::KernelSet& DataKernels::kernels(Isa isa) noexcept
+{
+    switch (isa)
+    {
+#ifdef DATA_KERNELS_X86
+        case Isa::avx2:
+            return avx2_kernels;
+        case Isa::sse41:
+            return sse41_kernels;
+#endif
+        default:
+            return scalar_kernels;
+    }
+}
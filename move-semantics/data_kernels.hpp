@@ -0,0 +1,91 @@
+#ifndef DATA_KERNELS_HPP
+#define DATA_KERNELS_HPP
+
+#include <cstddef>
+#include <iterator>
+
+////////////////////////////////////////////////////////////////////////////
+// DataKernels - reductions & transformations over contiguous int buffers
+//               (SSE4.1/AVX2 implementation is selected at runtime)
+
+namespace DataKernels
+{
+    enum class Isa
+    {
+        scalar,
+        sse41,
+        avx2
+    };
+
+    struct MinMax
+    {
+        int min;
+        int max;
+    };
+
+    struct KernelSet
+    {
+        long long (*sum)(const int* first, const int* last);
+        MinMax (*minmax)(const int* first, const int* last); // empty range -> {INT_MAX, INT_MIN}
+        size_t (*count_in_range)(const int* first, const int* last, int low, int high); // low <= x <= high
+        void (*scale_offset)(int* first, int* last, int factor, int offset); // x = x * factor + offset (wraps on overflow)
+    };
+
+    bool is_supported(Isa isa) noexcept;
+
+    Isa best_isa() noexcept;
+
+    // requires is_supported(isa)
+    const KernelSet& kernels(Isa isa) noexcept;
+
+    namespace Detail
+    {
+        template <typename TData>
+        auto data_ptr(TData& data) -> decltype(&*std::begin(data))
+        {
+            return std::begin(data) == std::end(data) ? nullptr : &*std::begin(data);
+        }
+
+        template <typename TData>
+        size_t data_size(const TData& data)
+        {
+            return static_cast<size_t>(std::end(data) - std::begin(data));
+        }
+
+        inline const KernelSet& best_kernels() noexcept
+        {
+            static const KernelSet& best = kernels(best_isa());
+            return best;
+        }
+    }
+
+    template <typename TData>
+    long long sum(const TData& data)
+    {
+        const int* first = Detail::data_ptr(data);
+        return Detail::best_kernels().sum(first, first + Detail::data_size(data));
+    }
+
+    template <typename TData>
+    MinMax minmax(const TData& data)
+    {
+        const int* first = Detail::data_ptr(data);
+        return Detail::best_kernels().minmax(first, first + Detail::data_size(data));
+    }
+
+    template <typename TData>
+    size_t count_in_range(const TData& data, int low, int high)
+    {
+        const int* first = Detail::data_ptr(data);
+        return Detail::best_kernels().count_in_range(first, first + Detail::data_size(data), low, high);
+    }
+
+    template <typename TData>
+    void scale_offset(TData& data, int factor, int offset)
+    {
+        int* first = Detail::data_ptr(data);
+        Detail::best_kernels().scale_offset(first, first + Detail::data_size(data), factor, offset);
+    }
+}
+
+#endif
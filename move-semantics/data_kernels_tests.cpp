@@ -0,0 +1,138 @@
+#include "catch.hpp"
+#include "data.hpp"
+#include "data_kernels.hpp"
+#include <algorithm>
+#include <climits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using DataKernels::Isa;
+
+namespace
+{
+    std::vector<int> random_items(size_t size, unsigned seed = 42)
+    {
+        std::mt19937 rnd {seed};
+        std::uniform_int_distribution<int> distr {INT_MIN, INT_MAX};
+
+        std::vector<int> items(size);
+        std::generate(items.begin(), items.end(), [&] { return distr(rnd); });
+        return items;
+    }
+}
+
+TEST_CASE("DataKernels - Data & ModernCpp::Data")
+{
+    Data ds {"ds", {1, 2, 53, 45, 645, 75647, 7561, 2, 3, 4, 5}};
+    ModernCpp::Data modern_ds {"modern_ds", {1, 2, 53, 45, 645, 75647, 7561, 2, 3, 4, 5}};
+
+    REQUIRE(DataKernels::sum(ds) == 83968);
+    REQUIRE(DataKernels::sum(modern_ds) == 83968);
+
+    auto [min, max] = DataKernels::minmax(ds);
+    REQUIRE(min == 1);
+    REQUIRE(max == 75647);
+
+    REQUIRE(DataKernels::count_in_range(modern_ds, 2, 53) == 7);
+
+    DataKernels::scale_offset(ds, 2, 1);
+    REQUIRE(std::vector<int>(ds.begin(), ds.end()) == std::vector<int> {3, 5, 107, 91, 1291, 151295, 15123, 5, 7, 9, 11});
+}
+
+TEST_CASE("DataKernels - empty range")
+{
+    std::vector<int> empty;
+
+    REQUIRE(DataKernels::sum(empty) == 0);
+    REQUIRE(DataKernels::minmax(empty).min == INT_MAX);
+    REQUIRE(DataKernels::minmax(empty).max == INT_MIN);
+    REQUIRE(DataKernels::count_in_range(empty, INT_MIN, INT_MAX) == 0);
+}
+
+TEST_CASE("DataKernels - SIMD results are identical to scalar fallback")
+{
+    const auto isa = GENERATE(Isa::sse41, Isa::avx2);
+
+    if (!DataKernels::is_supported(isa))
+        return;
+
+    const auto& scalar = DataKernels::kernels(Isa::scalar);
+    const auto& simd = DataKernels::kernels(isa);
+
+    for (size_t size : {0u, 1u, 3u, 7u, 8u, 9u, 31u, 1000u, 4099u})
+    {
+        std::vector<int> items = random_items(size);
+        const int* first = items.data();
+        const int* last = items.data() + items.size();
+
+        CAPTURE(static_cast<int>(isa), size);
+
+        REQUIRE(simd.sum(first, last) == scalar.sum(first, last));
+        REQUIRE(simd.sum(first, last) == std::accumulate(first, last, 0LL));
+
+        REQUIRE(simd.minmax(first, last).min == scalar.minmax(first, last).min);
+        REQUIRE(simd.minmax(first, last).max == scalar.minmax(first, last).max);
+
+        REQUIRE(simd.count_in_range(first, last, -1'000'000'000, 1'000'000'000) == scalar.count_in_range(first, last, -1'000'000'000, 1'000'000'000));
+        REQUIRE(simd.count_in_range(first, last, INT_MIN, INT_MAX) == size);
+
+        std::vector<int> simd_scaled = items;
+        std::vector<int> scalar_scaled = items;
+        simd.scale_offset(simd_scaled.data(), simd_scaled.data() + size, 3, -7);
+        scalar.scale_offset(scalar_scaled.data(), scalar_scaled.data() + size, 3, -7);
+        REQUIRE(simd_scaled == scalar_scaled);
+    }
+}
+
+TEST_CASE("DataKernels - reductions", "[.][benchmark]")
+{
+    std::cout << "best ISA: " << static_cast<int>(DataKernels::best_isa()) << " (0 - scalar, 1 - sse4.1, 2 - avx2)\n";
+
+    for (size_t size : {1'000u, 100'000u, 10'000'000u, 100'000'000u})
+    {
+        std::vector<int> items = random_items(size);
+        const std::string suffix = " - " + std::to_string(size);
+
+        BENCHMARK("std::accumulate" + suffix)
+        {
+            return std::accumulate(items.begin(), items.end(), 0LL);
+        };
+
+        BENCHMARK("DataKernels::sum" + suffix)
+        {
+            return DataKernels::sum(items);
+        };
+
+        BENCHMARK("std::minmax_element" + suffix)
+        {
+            return std::minmax_element(items.begin(), items.end());
+        };
+
+        BENCHMARK("DataKernels::minmax" + suffix)
+        {
+            return DataKernels::minmax(items);
+        };
+
+        BENCHMARK("std::count_if" + suffix)
+        {
+            return std::count_if(items.begin(), items.end(), [](int x) { return -1000 <= x && x <= 1000; });
+        };
+
+        BENCHMARK("DataKernels::count_in_range" + suffix)
+        {
+            return DataKernels::count_in_range(items, -1000, 1000);
+        };
+
+        BENCHMARK("std::transform" + suffix)
+        {
+            std::transform(items.begin(), items.end(), items.begin(), [](int x) { return static_cast<int>(static_cast<unsigned>(x) * 3u + 1u); });
+        };
+
+        BENCHMARK("DataKernels::scale_offset" + suffix)
+        {
+            DataKernels::scale_offset(items, 3, 1);
+        };
+    }
+}
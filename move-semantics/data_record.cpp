@@ -0,0 +1,91 @@
+#include "catch.hpp"
+#include "alloc_stats.hpp"
+#include "data.hpp"
+#include "data_record.hpp"
+#include <vector>
+
+namespace
+{
+    // same shape as RuleOfZero::DataRows
+    struct DataRows
+    {
+        Data row1;
+        Data row2;
+    };
+}
+
+TEST_CASE("DataRecord - rows in one allocation")
+{
+    AllocStats::Scope alloc_scope;
+    DataRecord<2> rows {{"row1", {1, 2, 3}}, {"row2", {6, 7, 8, 9}}};
+    const size_t allocations = alloc_scope.allocations();
+
+    REQUIRE(allocations == 1);
+    REQUIRE(rows.rows() == 2);
+    REQUIRE(rows[0].name() == "row1");
+    REQUIRE(rows[1].name() == "row2");
+    REQUIRE(std::vector<int>(rows[0].begin(), rows[0].end()) == std::vector<int> {1, 2, 3});
+    REQUIRE(std::vector<int>(rows[1].begin(), rows[1].end()) == std::vector<int> {6, 7, 8, 9});
+    REQUIRE(rows[1].begin() == rows[0].end());
+
+    SECTION("copy")
+    {
+        DataRecord<2> backup = rows;
+        *backup[0].begin() = 42;
+
+        REQUIRE(*rows[0].begin() == 1);
+        REQUIRE(backup[1].name() == "row2");
+    }
+
+    SECTION("move leaves empty record")
+    {
+        const int* items = rows[0].begin();
+
+        DataRecord<2> target_rows {std::move(rows)};
+
+        REQUIRE(target_rows[0].begin() == items);
+        REQUIRE(rows.empty());
+    }
+
+    SECTION("invalid number of rows")
+    {
+        REQUIRE_THROWS_AS((DataRecord<2> {{"row1", {1}}}), std::invalid_argument);
+    }
+}
+
+TEST_CASE("DataRecord vs. DataRows - construct & move", "[.][benchmark]")
+{
+    const int records_count = 1'000'000;
+
+    BENCHMARK("RuleOfZero::DataRows")
+    {
+        std::cout.setstate(std::ios::failbit); // silence Data traces
+        std::vector<DataRows> records;
+        records.reserve(records_count);
+        for (int i = 0; i < records_count; ++i)
+            records.push_back(DataRows {Data {"row1", {1, 2, 3}}, Data {"row2", {6, 7, 8}}});
+
+        std::vector<DataRows> target_records;
+        target_records.reserve(records_count);
+        for (auto& rows : records)
+            target_records.push_back(std::move(rows));
+        std::cout.clear();
+
+        return target_records.size();
+    };
+
+    BENCHMARK("DataRecord<2>")
+    {
+        std::vector<DataRecord<2>> records;
+        records.reserve(records_count);
+        for (int i = 0; i < records_count; ++i)
+            records.push_back(DataRecord<2> {{"row1", {1, 2, 3}}, {"row2", {6, 7, 8}}});
+
+        std::vector<DataRecord<2>> target_records;
+        target_records.reserve(records_count);
+        for (auto& rows : records)
+            target_records.push_back(std::move(rows));
+
+        return target_records.size();
+    };
+}
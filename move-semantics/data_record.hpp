@@ -0,0 +1,125 @@
+#ifndef DATA_RECORD_HPP
+#define DATA_RECORD_HPP
+
+#include "row_view.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+// DataRecord - fixed number of named rows stored in one allocation
+//              block layout: [item ends][name ends][items][name chars]
+//              rule of zero - moved-from record is empty
+
+template <size_t Rows>
+class DataRecord
+{
+    static_assert(Rows > 0, "record must have at least one row");
+
+    std::vector<int> block_;
+
+    const int* item_ends() const noexcept
+    {
+        return block_.data();
+    }
+
+    const int* name_ends() const noexcept
+    {
+        return block_.data() + Rows;
+    }
+
+    const char* names() const noexcept
+    {
+        return reinterpret_cast<const char*>(block_.data() + 2 * Rows + item_ends()[Rows - 1]);
+    }
+
+    size_t row_begin(size_t index) const noexcept
+    {
+        return index == 0 ? 0 : static_cast<size_t>(item_ends()[index - 1]);
+    }
+
+    std::string_view row_name(size_t index) const noexcept
+    {
+        const size_t first = index == 0 ? 0 : static_cast<size_t>(name_ends()[index - 1]);
+        return std::string_view {names() + first, name_ends()[index] - first};
+    }
+
+public:
+    using RowView = BasicRowView<int>;
+    using ConstRowView = BasicRowView<const int>;
+
+    struct RowInit
+    {
+        std::string_view name;
+        std::initializer_list<int> items;
+    };
+
+    DataRecord(std::initializer_list<RowInit> rows)
+    {
+        if (rows.size() != Rows)
+            throw std::invalid_argument("invalid number of rows in DataRecord");
+
+        size_t items_count = 0;
+        size_t name_chars = 0;
+        for (const auto& row : rows)
+        {
+            items_count += row.items.size();
+            name_chars += row.name.size();
+        }
+
+        const size_t name_ints = (name_chars + sizeof(int) - 1) / sizeof(int);
+        block_.resize(2 * Rows + items_count + name_ints);
+
+        int* ends = block_.data();
+        int* items = block_.data() + 2 * Rows;
+        char* name_chars_dest = reinterpret_cast<char*>(items + items_count);
+
+        size_t items_end = 0;
+        size_t names_end = 0;
+        for (const auto& row : rows)
+        {
+            std::copy(row.items.begin(), row.items.end(), items + items_end);
+            std::memcpy(name_chars_dest + names_end, row.name.data(), row.name.size());
+
+            items_end += row.items.size();
+            names_end += row.name.size();
+
+            ends[0] = static_cast<int>(items_end);
+            ends[Rows] = static_cast<int>(names_end);
+            ++ends;
+        }
+    }
+
+    static constexpr size_t rows() noexcept
+    {
+        return Rows;
+    }
+
+    // true for moved-from record
+    bool empty() const noexcept
+    {
+        return block_.empty();
+    }
+
+    RowView operator[](size_t index) noexcept
+    {
+        assert(!empty() && index < Rows);
+
+        int* items = block_.data() + 2 * Rows;
+        return RowView {row_name(index), items + row_begin(index), items + item_ends()[index]};
+    }
+
+    ConstRowView operator[](size_t index) const noexcept
+    {
+        assert(!empty() && index < Rows);
+
+        const int* items = block_.data() + 2 * Rows;
+        return ConstRowView {row_name(index), items + row_begin(index), items + item_ends()[index]};
+    }
+};
+
+#endif
@@ -0,0 +1,126 @@
+#include "catch.hpp"
+#include "data.hpp"
+#include "data_kernels.hpp"
+#include "data_set.hpp"
+#include <numeric>
+#include <string>
+#include <vector>
+
+TEST_CASE("DataSet - rows are stored in one buffer")
+{
+    DataSet ds;
+
+    ds.append("ds1", {1, 2, 3});
+    ds.append("ds2", {});
+    ds.append("ds1", std::vector<int> {4, 5});
+
+    REQUIRE(ds.rows() == 3);
+    REQUIRE(ds.names_count() == 2);
+    REQUIRE(ds.items() == std::vector<int> {1, 2, 3, 4, 5});
+
+    SECTION("row views")
+    {
+        REQUIRE(ds[0].name() == "ds1");
+        REQUIRE(std::vector<int>(ds[0].begin(), ds[0].end()) == std::vector<int> {1, 2, 3});
+        REQUIRE(ds[1].size() == 0);
+        REQUIRE(ds[2].name().data() == ds[0].name().data()); // interned name
+        REQUIRE(ds[2].begin() == ds[0].end() + ds[1].size());
+
+        for (int& item : ds[2])
+            item *= 10;
+
+        REQUIRE(ds.items() == std::vector<int> {1, 2, 3, 40, 50});
+    }
+
+    SECTION("row of the same set is appended")
+    {
+        for (int i = 0; i < 4; ++i) // buffer grows while source row points into it
+            ds.append(ds[0].name(), ds[0]);
+
+        REQUIRE(ds.rows() == 7);
+        REQUIRE(ds.names_count() == 2);
+        REQUIRE(ds.items() == std::vector<int> {1, 2, 3, 4, 5, 1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 2, 3});
+    }
+
+    SECTION("items of the same set are appended as one row")
+    {
+        ds.append("all", ds.items());
+
+        REQUIRE(ds.rows() == 4);
+        REQUIRE(std::vector<int>(ds[3].begin(), ds[3].end()) == std::vector<int> {1, 2, 3, 4, 5});
+        REQUIRE(ds.items() == std::vector<int> {1, 2, 3, 4, 5, 1, 2, 3, 4, 5});
+    }
+
+    SECTION("iteration over rows")
+    {
+        std::vector<std::string> names;
+        for (const auto& row : ds)
+            names.emplace_back(row.name());
+
+        REQUIRE(names == std::vector<std::string> {"ds1", "ds2", "ds1"});
+    }
+
+    SECTION("copy keeps own name table")
+    {
+        DataSet backup = ds;
+        ds = DataSet {};
+        backup.append("ds2", {6});
+
+        REQUIRE(backup.names_count() == 2);
+        REQUIRE(backup[3].name() == "ds2");
+        REQUIRE(ds.empty());
+    }
+}
+
+TEST_CASE("DataSet - bulk load of Data rows")
+{
+    std::vector<ModernCpp::Data> rows;
+    rows.emplace_back("row1", std::initializer_list<int> {1, 2, 3});
+    rows.emplace_back("row2", std::initializer_list<int> {6, 7, 8});
+
+    DataSet ds;
+    ds.append("row0", Data {"row0", {0}});
+    ds.append_rows(rows.begin(), rows.end());
+
+    REQUIRE(ds.rows() == 3);
+    REQUIRE(ds[2].name() == "row2");
+    REQUIRE(ds.items() == std::vector<int> {0, 1, 2, 3, 6, 7, 8});
+    REQUIRE(DataKernels::sum(ds.items()) == 27);
+}
+
+TEST_CASE("DataSet - full scan", "[.][benchmark]")
+{
+    const int rows_count = 100'000;
+
+    std::vector<ModernCpp::Data> rows;
+    rows.reserve(rows_count);
+
+    std::cout.setstate(std::ios::failbit); // silence Data traces
+    for (int i = 0; i < rows_count; ++i)
+        rows.emplace_back("row-" + std::to_string(i % 100), std::initializer_list<int> {i, 2, 53, 45, 645, 75647, 7561, 2, 3, 4, 5});
+    std::cout.clear();
+
+    DataSet ds;
+    ds.append_rows(rows.begin(), rows.end());
+
+    BENCHMARK("std::vector<ModernCpp::Data> - scan")
+    {
+        long long sum {};
+        for (const auto& row : rows)
+            sum = std::accumulate(row.begin(), row.end(), sum);
+        return sum;
+    };
+
+    BENCHMARK("DataSet - scan of rows")
+    {
+        long long sum {};
+        for (const auto& row : ds)
+            sum = std::accumulate(row.begin(), row.end(), sum);
+        return sum;
+    };
+
+    BENCHMARK("DataSet - scan of column")
+    {
+        return std::accumulate(ds.items().begin(), ds.items().end(), 0LL);
+    };
+}
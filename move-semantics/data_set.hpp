@@ -0,0 +1,259 @@
+#ifndef DATA_SET_HPP
+#define DATA_SET_HPP
+
+#include "row_view.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+// DataSet - columnar container of Data rows
+//           items of all rows are stored back to back in one buffer,
+//           row i ends at offsets[i] (and starts where row i - 1 ends), names are interned
+
+class DataSet
+{
+public:
+    using RowView = BasicRowView<int>;
+    using ConstRowView = BasicRowView<const int>;
+
+private:
+    std::vector<int> items_;
+    std::vector<size_t> offsets_;
+    std::vector<uint32_t> name_ids_;
+
+    std::deque<std::string> names_; // deque - interned strings never move
+    std::unordered_map<std::string_view, uint32_t> name_index_;
+
+    uint32_t intern(std::string_view name)
+    {
+        auto it = name_index_.find(name);
+        if (it != name_index_.end())
+            return it->second;
+
+        const auto id = static_cast<uint32_t>(names_.size());
+        names_.emplace_back(name);
+        name_index_.emplace(names_.back(), id);
+
+        return id;
+    }
+
+    size_t row_begin(size_t index) const noexcept
+    {
+        return index == 0 ? 0 : offsets_[index - 1];
+    }
+
+    template <typename TIter>
+    void append_items(std::string_view name, TIter first, TIter last)
+    {
+        // source may be a row of this set (RowView, items()) - inserting own elements is not allowed
+        // by vector::insert(), so they are copied by index (growth of buffer invalidates iterators)
+        if constexpr (std::contiguous_iterator<TIter> && std::is_same_v<std::iter_value_t<TIter>, int>)
+        {
+            const int* data = items_.data();
+            const int* source = first != last ? std::to_address(first) : nullptr;
+            if (source && std::less_equal<> {}(data, source) && std::less<> {}(source, data + items_.size()))
+            {
+                const auto offset = static_cast<size_t>(source - data);
+                const auto count = static_cast<size_t>(last - first);
+                const size_t old_size = items_.size();
+
+                items_.resize(old_size + count);
+                std::copy_n(items_.begin() + static_cast<std::ptrdiff_t>(offset), count, items_.begin() + static_cast<std::ptrdiff_t>(old_size));
+            }
+            else
+                items_.insert(items_.end(), first, last);
+        }
+        else
+            items_.insert(items_.end(), first, last);
+
+        offsets_.push_back(items_.size());
+        name_ids_.push_back(intern(name));
+    }
+
+public:
+    template <bool IsConst>
+    class RowIterator
+    {
+        using DataSetType = std::conditional_t<IsConst, const DataSet, DataSet>;
+
+        DataSetType* data_set_;
+        size_t index_;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::conditional_t<IsConst, ConstRowView, RowView>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        RowIterator(DataSetType* data_set, size_t index) noexcept
+            : data_set_ {data_set}
+            , index_ {index}
+        {
+        }
+
+        reference operator*() const
+        {
+            return (*data_set_)[index_];
+        }
+
+        RowIterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        RowIterator operator++(int) noexcept
+        {
+            return RowIterator {data_set_, index_++};
+        }
+
+        bool operator==(const RowIterator& other) const noexcept
+        {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const RowIterator& other) const noexcept
+        {
+            return index_ != other.index_;
+        }
+    };
+
+    using iterator = RowIterator<false>;
+    using const_iterator = RowIterator<true>;
+
+    DataSet() = default;
+
+    // name index must refer to names interned by this set
+    DataSet(const DataSet& other)
+        : items_ {other.items_}
+        , offsets_ {other.offsets_}
+        , name_ids_ {other.name_ids_}
+        , names_ {other.names_}
+    {
+        for (uint32_t id = 0; id < names_.size(); ++id)
+            name_index_.emplace(names_[id], id);
+    }
+
+    DataSet& operator=(const DataSet& other)
+    {
+        DataSet temp(other);
+        swap(temp);
+
+        return *this;
+    }
+
+    DataSet(DataSet&&) = default;
+    DataSet& operator=(DataSet&&) = default;
+
+    void swap(DataSet& other) noexcept
+    {
+        items_.swap(other.items_);
+        offsets_.swap(other.offsets_);
+        name_ids_.swap(other.name_ids_);
+        names_.swap(other.names_);
+        name_index_.swap(other.name_index_);
+    }
+
+    void reserve(size_t rows, size_t items)
+    {
+        items_.reserve(items);
+        offsets_.reserve(rows);
+        name_ids_.reserve(rows);
+    }
+
+    void append(std::string_view name, std::initializer_list<int> list)
+    {
+        append_items(name, list.begin(), list.end());
+    }
+
+    // row - any range of ints (Data, ModernCpp::Data, SmallData, RowView...)
+    template <typename TRow>
+    void append(std::string_view name, const TRow& row)
+    {
+        append_items(name, std::begin(row), std::end(row));
+    }
+
+    // bulk load of rows with name(), begin() & end() - storage is reserved once
+    template <typename TIter>
+    void append_rows(TIter first, TIter last)
+    {
+        size_t rows_count = 0;
+        size_t items_count = 0;
+        for (auto it = first; it != last; ++it, ++rows_count)
+            items_count += static_cast<size_t>(std::distance(std::begin(*it), std::end(*it)));
+
+        reserve(rows() + rows_count, items_.size() + items_count);
+
+        for (; first != last; ++first)
+            append_items(first->name(), std::begin(*first), std::end(*first));
+    }
+
+    size_t rows() const noexcept
+    {
+        return name_ids_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return name_ids_.empty();
+    }
+
+    RowView operator[](size_t index)
+    {
+        assert(index < rows());
+        return RowView {names_[name_ids_[index]], items_.data() + row_begin(index), items_.data() + offsets_[index]};
+    }
+
+    ConstRowView operator[](size_t index) const
+    {
+        assert(index < rows());
+        return ConstRowView {names_[name_ids_[index]], items_.data() + row_begin(index), items_.data() + offsets_[index]};
+    }
+
+    // full column - items of all rows (for scans)
+    const std::vector<int>& items() const noexcept
+    {
+        return items_;
+    }
+
+    // number of distinct names
+    size_t names_count() const noexcept
+    {
+        return names_.size();
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator {this, 0};
+    }
+
+    iterator end() noexcept
+    {
+        return iterator {this, rows()};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator {this, 0};
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator {this, rows()};
+    }
+};
+
+#endif
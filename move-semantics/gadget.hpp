@@ -1,43 +1,58 @@
 #ifndef GADGET_HPP
 #define GADGET_HPP
 
+#include "instrumentation.hpp"
+#include "string_interner.hpp"
+#include "trace.hpp"
 #include <iostream>
 #include <string>
 
-struct Gadget
+// TName - std::string (owning name) or InternedString (handle of name in StringInterner)
+template <typename TName>
+struct BasicGadget
 {
     int id{};
-    std::string name{"not-set"};
+    [[no_unique_address]] Instrumentation::Tracked<BasicGadget> tracked_; // no space when instrumentation is disabled
+    TName name{"not-set"};
 
-    Gadget() = default;
+    BasicGadget() = default;
 
-    explicit Gadget(int v)
+    explicit BasicGadget(int v)
         : id{v}
     {
-        std::cout << "Gadget(" << id << ")\n";
+        Trace::write("Gadget(", id, ")\n");
     }
 
-    Gadget(int v, const std::string& n)
+    BasicGadget(int v, const TName& n)
         : id{v}
         , name{n}
     {
-        std::cout << "Gadget(" << id << ", " << name << ")\n";
+        Trace::write("Gadget(", id, ", ", name, ")\n");
     }
 
-    Gadget(const Gadget&) = default;
-    Gadget& operator=(const Gadget&) = default;
-    Gadget(Gadget&&) = default;
-    Gadget& operator=(Gadget&&) = default;
+    BasicGadget(const BasicGadget&) = default;
+    BasicGadget& operator=(const BasicGadget&) = default;
+    BasicGadget(BasicGadget&&) = default;
+    BasicGadget& operator=(BasicGadget&&) = default;
 
-    ~Gadget()
+    ~BasicGadget()
     {
-        std::cout << "~Gadget(" << id << ", " << name << ")\n";
+        Trace::write("~Gadget(", id, ", ", name, ")\n");
     }
 
     void use() const
+    {
+        print_use(id, name);
+    }
+
+    // output of use() is gadget's work (not a trace) - shared with GadgetStore, which keeps id & name outside of gadget
+    static void print_use(int id, const TName& name)
     {
         std::cout << "Using Gadget(" << id << ", " << name << ")\n";
     }
 };
 
+using Gadget = BasicGadget<std::string>;
+using InternedGadget = BasicGadget<InternedString>;
+
 #endif
\ No newline at end of file
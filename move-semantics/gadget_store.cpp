@@ -0,0 +1,137 @@
+#include "catch.hpp"
+#include "alloc_stats.hpp"
+#include "gadget.hpp"
+#include "gadget_store.hpp"
+#include "unique_ptr.hpp"
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+TEST_CASE("GadgetStore - handles")
+{
+    GadgetStore store;
+
+    GadgetHandle ipad = store.add(1, "ipad");
+    GadgetHandle ipod = store.add(Gadget {2, "ipod"});
+    GadgetHandle imac = store.add(3, "imac");
+
+    REQUIRE(store.size() == 3);
+    REQUIRE(store.name(ipod) == "ipod");
+    REQUIRE(store.gadget(imac).id == 3);
+
+    store.id(ipad) = 10;
+    REQUIRE(std::vector<int>(store.ids().begin(), store.ids().end()) == std::vector<int> {10, 2, 3});
+
+    SECTION("remove keeps arrays dense & other handles valid")
+    {
+        store.remove(ipad);
+
+        REQUIRE(store.size() == 2);
+        REQUIRE_FALSE(store.contains(ipad));
+        REQUIRE(store.name(imac) == "imac");
+        REQUIRE(store.name(ipod) == "ipod");
+        REQUIRE(std::vector<int>(store.ids().begin(), store.ids().end()) == std::vector<int> {3, 2});
+
+        SECTION("slot of removed gadget is reused with new generation")
+        {
+            GadgetHandle iphone = store.add(4, "iphone");
+
+            REQUIRE(iphone.index == ipad.index);
+            REQUIRE_FALSE(store.contains(ipad));
+            REQUIRE(store.contains(iphone));
+            REQUIRE(store.id(iphone) == 4);
+        }
+    }
+
+    SECTION("bulk iteration")
+    {
+        std::vector<std::string> names;
+        store.for_each([&names](int, const std::string& name) { names.push_back(name); });
+
+        REQUIRE(names == std::vector<std::string> {"ipad", "ipod", "imac"});
+    }
+}
+
+TEST_CASE("GadgetStore - add() keeps arrays in sync when allocation fails")
+{
+    const int initial_count = 8;
+
+    // n-th allocation made by add() fails - growth of ids_, names_, owners_ & slots_
+    for (size_t n = 0; n < 4; ++n)
+    {
+        GadgetStore store;
+        store.reserve(initial_count);
+
+        std::vector<GadgetHandle> handles;
+        for (int i = 0; i < initial_count; ++i)
+            handles.push_back(store.add(i, "gadget-" + std::to_string(i)));
+
+        std::string name = "gadget-added-when-store-is-full";
+        {
+            AllocStats::FailingScope failing_scope {n};
+            REQUIRE_THROWS_AS(store.add(initial_count, std::move(name)), std::bad_alloc);
+            REQUIRE(failing_scope.has_failed());
+        }
+
+        REQUIRE(store.size() == initial_count);
+        REQUIRE(store.ids().size() == initial_count);
+        REQUIRE(store.names().size() == initial_count);
+        for (int i = 0; i < initial_count; ++i)
+        {
+            REQUIRE(store.contains(handles[i]));
+            REQUIRE(store.id(handles[i]) == i);
+            REQUIRE(store.name(handles[i]) == "gadget-" + std::to_string(i));
+        }
+
+        GadgetHandle added = store.add(initial_count, "gadget-added");
+        REQUIRE(store.size() == initial_count + 1);
+        REQUIRE(store.id(added) == initial_count);
+        REQUIRE(store.names().back() == "gadget-added");
+    }
+}
+
+TEST_CASE("GadgetStore vs. std::vector<UniquePtr<Gadget>> - scan", "[.][benchmark]")
+{
+    const int gadgets_count = 1'000'000;
+
+    std::vector<UniquePtr<Gadget>> gadgets;
+    GadgetStore store;
+    store.reserve(gadgets_count);
+
+    std::cout.setstate(std::ios::failbit); // silence Gadget traces
+    for (int id = 1; id <= gadgets_count; ++id)
+    {
+        gadgets.push_back(MakeUnique<Gadget>(id, "Gadget-" + std::to_string(id)));
+        store.add(id, "Gadget-" + std::to_string(id));
+    }
+    std::cout.clear();
+
+    BENCHMARK("std::vector<UniquePtr<Gadget>> - sum of ids")
+    {
+        long long sum = 0;
+        for (const auto& g : gadgets)
+            sum += g->id;
+        return sum;
+    };
+
+    BENCHMARK("GadgetStore - sum of ids")
+    {
+        return std::accumulate(store.ids().begin(), store.ids().end(), 0LL);
+    };
+
+    BENCHMARK("std::vector<UniquePtr<Gadget>> - id & name")
+    {
+        size_t total = 0;
+        for (const auto& g : gadgets)
+            total += g->id + g->name.size();
+        return total;
+    };
+
+    BENCHMARK("GadgetStore - for_each(id, name)")
+    {
+        size_t total = 0;
+        store.for_each([&total](int id, const std::string& name) { total += id + name.size(); });
+        return total;
+    };
+}
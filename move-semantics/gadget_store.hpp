@@ -0,0 +1,204 @@
+#ifndef GADGET_STORE_HPP
+#define GADGET_STORE_HPP
+
+#include "gadget.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+// GadgetHandle - stable reference to gadget in GadgetStore
+//                (generation detects handles of removed gadgets)
+
+struct GadgetHandle
+{
+    uint32_t index;
+    uint32_t generation;
+
+    bool operator==(const GadgetHandle&) const = default;
+};
+
+////////////////////////////////////////////////////////////////////////////
+// GadgetStore - gadgets stored as struct of arrays (ids & names in parallel dense arrays)
+//               scan of ids() touches only id array, remove() moves last gadget into the gap
+
+class GadgetStore
+{
+    // dense arrays - item i of each array belongs to the same gadget
+    std::vector<int> ids_;
+    std::vector<std::string> names_;
+    std::vector<uint32_t> owners_; // dense index -> handle index
+
+    // sparse table - handle index -> dense index
+    struct Slot
+    {
+        uint32_t dense_index;
+        uint32_t generation;
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_slots_;
+
+    // grows vector geometrically before add() changes any array - push_back() cannot throw afterwards
+    template <typename T>
+    static void reserve_one_more(std::vector<T>& items)
+    {
+        if (items.size() == items.capacity())
+            items.reserve(std::max<size_t>(8, 2 * items.capacity()));
+    }
+
+    size_t dense_index(GadgetHandle handle) const noexcept
+    {
+        assert(contains(handle));
+        return slots_[handle.index].dense_index;
+    }
+
+public:
+    GadgetStore() = default;
+
+    void reserve(size_t capacity)
+    {
+        ids_.reserve(capacity);
+        names_.reserve(capacity);
+        owners_.reserve(capacity);
+        slots_.reserve(capacity);
+    }
+
+    size_t size() const noexcept
+    {
+        return ids_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return ids_.empty();
+    }
+
+    GadgetHandle add(int id, std::string name)
+    {
+        reserve_one_more(ids_);
+        reserve_one_more(names_);
+        reserve_one_more(owners_);
+        if (free_slots_.empty())
+            reserve_one_more(slots_);
+
+        uint32_t slot_index;
+        if (free_slots_.empty())
+        {
+            slot_index = static_cast<uint32_t>(slots_.size());
+            slots_.push_back(Slot {0, 0});
+        }
+        else
+        {
+            slot_index = free_slots_.back();
+            free_slots_.pop_back();
+        }
+
+        const auto dense_index = static_cast<uint32_t>(ids_.size());
+        ids_.push_back(id);
+        names_.push_back(std::move(name));
+        owners_.push_back(slot_index);
+
+        slots_[slot_index].dense_index = dense_index;
+
+        return GadgetHandle {slot_index, slots_[slot_index].generation};
+    }
+
+    GadgetHandle add(const Gadget& g)
+    {
+        return add(g.id, g.name);
+    }
+
+    bool contains(GadgetHandle handle) const noexcept
+    {
+        return handle.index < slots_.size() && slots_[handle.index].generation == handle.generation;
+    }
+
+    void remove(GadgetHandle handle)
+    {
+        const size_t index = dense_index(handle);
+        const size_t last = ids_.size() - 1;
+
+        if (index != last)
+        {
+            ids_[index] = ids_[last];
+            names_[index] = std::move(names_[last]);
+            owners_[index] = owners_[last];
+            slots_[owners_[index]].dense_index = static_cast<uint32_t>(index);
+        }
+
+        ids_.pop_back();
+        names_.pop_back();
+        owners_.pop_back();
+
+        ++slots_[handle.index].generation;
+        free_slots_.push_back(handle.index);
+    }
+
+    int& id(GadgetHandle handle) noexcept
+    {
+        return ids_[dense_index(handle)];
+    }
+
+    int id(GadgetHandle handle) const noexcept
+    {
+        return ids_[dense_index(handle)];
+    }
+
+    std::string& name(GadgetHandle handle) noexcept
+    {
+        return names_[dense_index(handle)];
+    }
+
+    const std::string& name(GadgetHandle handle) const noexcept
+    {
+        return names_[dense_index(handle)];
+    }
+
+    Gadget gadget(GadgetHandle handle) const
+    {
+        const size_t index = dense_index(handle);
+        return Gadget {ids_[index], names_[index]};
+    }
+
+    void use(GadgetHandle handle) const
+    {
+        const size_t index = dense_index(handle);
+        Gadget::print_use(ids_[index], names_[index]);
+    }
+
+    // bulk access - order of gadgets changes after remove()
+    std::span<const int> ids() const noexcept
+    {
+        return ids_;
+    }
+
+    std::span<int> ids() noexcept
+    {
+        return ids_;
+    }
+
+    std::span<const std::string> names() const noexcept
+    {
+        return names_;
+    }
+
+    // calls f(id, name) for every gadget
+    template <typename TFunction>
+    void for_each(TFunction f) const
+    {
+        for (size_t i = 0; i < ids_.size(); ++i)
+            f(ids_[i], names_[i]);
+    }
+
+    void use_all() const
+    {
+        for_each(&Gadget::print_use);
+    }
+};
+
+#endif
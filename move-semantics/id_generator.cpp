@@ -0,0 +1,211 @@
+#include "catch.hpp"
+#include "id_generator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("IdGenerator - single thread")
+{
+    SECTION("blocks")
+    {
+        IdGenerator gen {1, 4};
+
+        std::vector<int> ids;
+        for (int i = 0; i < 10; ++i)
+            ids.push_back(gen.next());
+
+        REQUIRE(ids == std::vector<int> {1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+    }
+
+    SECTION("dense")
+    {
+        IdGenerator gen {100, 4, IdGenerator::Mode::dense};
+
+        REQUIRE(gen.next() == 100);
+        REQUIRE(gen.next() == 101);
+    }
+
+    SECTION("generators are independent")
+    {
+        IdGenerator gen1 {1, 8};
+        IdGenerator gen2 {1000, 8};
+
+        REQUIRE(gen1.next() == 1);
+        REQUIRE(gen2.next() == 1000);
+        REQUIRE(gen1.next() == 2);
+    }
+}
+
+TEST_CASE("IdGenerator - exhausted ids throw instead of wrapping around")
+{
+    const int max_id = std::numeric_limits<int>::max();
+
+    SECTION("blocks")
+    {
+        IdGenerator gen {max_id - 2, 2}; // the last block is shortened to INT_MAX
+
+        REQUIRE(gen.next() == max_id - 2);
+        REQUIRE(gen.next() == max_id - 1);
+        REQUIRE(gen.next() == max_id);
+        REQUIRE_THROWS_AS(gen.next(), std::overflow_error);
+        REQUIRE_THROWS_AS(gen.next(), std::overflow_error);
+    }
+
+    SECTION("dense")
+    {
+        IdGenerator gen {max_id - 1, 4, IdGenerator::Mode::dense};
+
+        REQUIRE(gen.next() == max_id - 1);
+        REQUIRE(gen.next() == max_id);
+        REQUIRE_THROWS_AS(gen.next(), std::overflow_error);
+    }
+}
+
+TEST_CASE("IdGenerator - cached blocks of destroyed generators are released")
+{
+    IdGenerator keeper {1, 1024};
+    keeper.next();
+
+    SECTION("generator destroyed by the same thread")
+    {
+        for (int i = 0; i < 1'000; ++i)
+        {
+            IdGenerator temp {1, 1024};
+            temp.next();
+            keeper.next(); // block of temp becomes cold
+        }
+
+        REQUIRE(IdGenerator::cached_blocks() <= 1);
+    }
+
+    SECTION("generator destroyed by other thread")
+    {
+        std::vector<std::unique_ptr<IdGenerator>> generators;
+        for (int i = 0; i < 100; ++i)
+            generators.push_back(std::make_unique<IdGenerator>(1, 1024));
+
+        std::atomic<int> phase {0};
+        size_t cached_before = 0;
+        size_t cached_after = 0;
+
+        std::thread worker {[&] {
+            for (auto& gen : generators)
+                gen->next();
+            keeper.next();
+            cached_before = IdGenerator::cached_blocks();
+
+            phase = 1;
+            while (phase != 2)
+                std::this_thread::yield();
+
+            IdGenerator fresh {1, 1024};
+            fresh.next(); // miss - blocks of destroyed generators are pruned
+            cached_after = IdGenerator::cached_blocks();
+        }};
+
+        while (phase != 1)
+            std::this_thread::yield();
+        generators.clear();
+        phase = 2;
+        worker.join();
+
+        REQUIRE(cached_before == 100);
+        REQUIRE(cached_after == 1); // block of keeper
+    }
+
+    SECTION("exhausted blocks are not cached")
+    {
+        IdGenerator small {1, 1};
+        small.next(); // block of size 1 is exhausted
+        keeper.next();
+
+        REQUIRE(IdGenerator::cached_blocks() == 0);
+    }
+}
+
+TEST_CASE("IdGenerator - many threads")
+{
+    const int threads_count = 8;
+    const int ids_per_thread = 10'000;
+
+    auto mode = GENERATE(IdGenerator::Mode::blocks, IdGenerator::Mode::dense);
+    IdGenerator gen {1, 64, mode};
+
+    std::vector<std::vector<int>> ids(threads_count);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threads_count; ++t)
+        threads.emplace_back([&gen, &thread_ids = ids[t]] {
+            for (int i = 0; i < ids_per_thread; ++i)
+                thread_ids.push_back(gen.next());
+        });
+
+    for (auto& thd : threads)
+        thd.join();
+
+    std::vector<int> all_ids;
+    for (const auto& thread_ids : ids)
+    {
+        REQUIRE(std::is_sorted(thread_ids.begin(), thread_ids.end()));
+        all_ids.insert(all_ids.end(), thread_ids.begin(), thread_ids.end());
+    }
+
+    std::sort(all_ids.begin(), all_ids.end());
+    REQUIRE(std::adjacent_find(all_ids.begin(), all_ids.end()) == all_ids.end()); // unique
+
+    if (mode == IdGenerator::Mode::dense)
+        REQUIRE(all_ids.back() == threads_count * ids_per_thread);
+}
+
+namespace
+{
+    // returns ids/s generated by threads_count threads
+    template <typename TNextId>
+    double measure_ids(int threads_count, int ids_per_thread, TNextId next_id)
+    {
+        std::atomic<long long> checksum {};
+
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threads_count; ++t)
+            threads.emplace_back([&] {
+                long long sum = 0;
+                for (int i = 0; i < ids_per_thread; ++i)
+                    sum += next_id();
+                checksum += sum;
+            });
+
+        for (auto& thd : threads)
+            thd.join();
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        return threads_count * ids_per_thread / elapsed.count();
+    }
+}
+
+TEST_CASE("IdGenerator vs. std::atomic<int> - scaling", "[.][benchmark]")
+{
+    const int ids_per_thread = 1'000'000;
+
+    std::cout << "threads | std::atomic<int> | IdGenerator - dense | IdGenerator - blocks [ids/s]\n";
+    for (int threads_count = 1; threads_count <= 16; threads_count *= 2)
+    {
+        std::atomic<int> counter {};
+        IdGenerator dense_gen {1, 1024, IdGenerator::Mode::dense};
+        IdGenerator blocks_gen {1, 1024};
+
+        const auto atomic_rate = measure_ids(threads_count, ids_per_thread, [&counter] { return ++counter; });
+        const auto dense_rate = measure_ids(threads_count, ids_per_thread, [&dense_gen] { return dense_gen.next(); });
+        const auto blocks_rate = measure_ids(threads_count, ids_per_thread, [&blocks_gen] { return blocks_gen.next(); });
+
+        std::cout << threads_count << " | " << static_cast<long long>(atomic_rate) << " | "
+                  << static_cast<long long>(dense_rate) << " | " << static_cast<long long>(blocks_rate) << "\n";
+    }
+}
@@ -0,0 +1,171 @@
+#ifndef ID_GENERATOR_HPP
+#define ID_GENERATOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+// IdGenerator - thread-safe source of unique ids (starting from first_id)
+//               blocks mode: thread reserves block of ids with one fetch_add & hands them out locally
+//                            ids increase within thread, ids left in block of exited thread are skipped
+//               dense mode:  one fetch_add per id - no gaps & global order (contended by many threads)
+//               ids never exceed INT_MAX - next() throws std::overflow_error when ids are exhausted
+//               (counter is 64-bit, so it does not wrap around to duplicate or negative ids)
+
+class IdGenerator
+{
+public:
+    enum class Mode
+    {
+        blocks,
+        dense
+    };
+
+private:
+    // ids reserved by calling thread
+    struct LocalBlock
+    {
+        uint64_t generator_serial;
+        int64_t next;
+        int64_t end;
+    };
+
+    static constexpr int64_t max_id = std::numeric_limits<int>::max();
+
+    [[noreturn]] static void throw_exhausted()
+    {
+        throw std::overflow_error("IdGenerator - ids are exhausted");
+    }
+
+    static inline std::atomic<uint64_t> serial_counter_ {};
+    // block of the most recently used generator (trivial thread_local - no init guard on fast path)
+    static inline thread_local LocalBlock hot_block_ {};
+
+    // blocks of other generators used by the calling thread - exhausted blocks are not kept,
+    // blocks of destroyed generators are dropped on the next lookup miss
+    static inline thread_local std::vector<LocalBlock> cold_blocks_;
+
+    // serials of live generators (sorted) - touched only by constructors, destructors & pruning
+    static inline std::mutex live_mtx_;
+    static inline std::vector<uint64_t> live_serials_;
+    static inline std::atomic<uint64_t> destroyed_count_ {};
+    static inline thread_local uint64_t pruned_at_destroyed_count_ {};
+
+    static void prune_cold_blocks()
+    {
+        const uint64_t destroyed_count = destroyed_count_.load(std::memory_order_acquire);
+        if (destroyed_count == pruned_at_destroyed_count_)
+            return;
+
+        std::lock_guard lk {live_mtx_};
+        std::erase_if(cold_blocks_, [](const LocalBlock& block) {
+            return !std::binary_search(live_serials_.begin(), live_serials_.end(), block.generator_serial);
+        });
+        pruned_at_destroyed_count_ = destroyed_count;
+    }
+
+    alignas(64) std::atomic<int64_t> next_ {};
+    const uint64_t serial_;
+    const int block_size_;
+    const Mode mode_;
+
+    // makes block of this generator hot & refills it if exhausted
+    int next_slow()
+    {
+        LocalBlock& hot = hot_block_;
+
+        if (hot.generator_serial != serial_)
+        {
+            if (hot.generator_serial != 0 && hot.next != hot.end)
+                cold_blocks_.push_back(hot);
+
+            auto it = std::find_if(cold_blocks_.begin(), cold_blocks_.end(),
+                [this](const LocalBlock& block) { return block.generator_serial == serial_; });
+
+            LocalBlock block = LocalBlock {serial_, 0, 0};
+            if (it != cold_blocks_.end())
+            {
+                block = *it;
+                cold_blocks_.erase(it);
+            }
+            else
+                prune_cold_blocks();
+
+            hot = block;
+        }
+
+        if (hot.next == hot.end)
+        {
+            const int64_t first = next_.fetch_add(block_size_, std::memory_order_relaxed);
+            if (first > max_id)
+                throw_exhausted();
+
+            hot.next = first;
+            hot.end = std::min(first + block_size_, max_id + 1);
+        }
+
+        return static_cast<int>(hot.next++);
+    }
+
+public:
+    explicit IdGenerator(int first_id = 1, int block_size = 1024, Mode mode = Mode::blocks)
+        : next_ {first_id}
+        , serial_ {++serial_counter_}
+        , block_size_ {block_size}
+        , mode_ {mode}
+    {
+        assert(block_size_ > 0);
+
+        std::lock_guard lk {live_mtx_};
+        live_serials_.insert(std::upper_bound(live_serials_.begin(), live_serials_.end(), serial_), serial_);
+    }
+
+    ~IdGenerator()
+    {
+        {
+            std::lock_guard lk {live_mtx_};
+            live_serials_.erase(std::lower_bound(live_serials_.begin(), live_serials_.end(), serial_));
+        }
+        // thread-locals are not touched - static generator may outlive them at exit
+        destroyed_count_.fetch_add(1, std::memory_order_release);
+    }
+
+    IdGenerator(const IdGenerator&) = delete;
+    IdGenerator& operator=(const IdGenerator&) = delete;
+
+    Mode mode() const noexcept
+    {
+        return mode_;
+    }
+
+    int next()
+    {
+        if (mode_ == Mode::dense)
+        {
+            const int64_t id = next_.fetch_add(1, std::memory_order_relaxed);
+            if (id > max_id)
+                throw_exhausted();
+            return static_cast<int>(id);
+        }
+
+        LocalBlock& hot = hot_block_;
+        if (hot.generator_serial == serial_ && hot.next != hot.end)
+            return static_cast<int>(hot.next++);
+
+        return next_slow();
+    }
+
+    // number of blocks of not recently used generators cached by the calling thread
+    static size_t cached_blocks() noexcept
+    {
+        return cold_blocks_.size();
+    }
+};
+
+#endif
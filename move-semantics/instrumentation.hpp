@@ -0,0 +1,139 @@
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include <atomic>
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////////////////
+// Instrumentation - per-type counters of copies, moves & allocations
+//                   (enabled with ENABLE_INSTRUMENTATION - otherwise all calls are discarded)
+
+namespace Instrumentation
+{
+#ifdef ENABLE_INSTRUMENTATION
+    constexpr bool enabled = true;
+#else
+    constexpr bool enabled = false;
+#endif
+
+    enum class Event
+    {
+        copy_construction,
+        move_construction,
+        copy_assignment,
+        move_assignment
+    };
+
+    struct Snapshot
+    {
+        size_t copy_constructions {};
+        size_t move_constructions {};
+        size_t copy_assignments {};
+        size_t move_assignments {};
+        size_t allocations {};
+        size_t bytes {};
+
+        size_t copies() const noexcept
+        {
+            return copy_constructions + copy_assignments;
+        }
+
+        size_t moves() const noexcept
+        {
+            return move_constructions + move_assignments;
+        }
+
+        Snapshot operator-(const Snapshot& start) const noexcept
+        {
+            return Snapshot {copy_constructions - start.copy_constructions, move_constructions - start.move_constructions,
+                copy_assignments - start.copy_assignments, move_assignments - start.move_assignments,
+                allocations - start.allocations, bytes - start.bytes};
+        }
+    };
+
+    namespace Detail
+    {
+        template <typename T>
+        struct Counters
+        {
+            static inline std::atomic<size_t> events[4] {};
+            static inline std::atomic<size_t> allocations {};
+            static inline std::atomic<size_t> bytes {};
+        };
+    }
+
+    template <typename T>
+    inline void record(Event event) noexcept
+    {
+        if constexpr (enabled)
+            Detail::Counters<T>::events[static_cast<size_t>(event)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    inline void record_allocation(size_t bytes) noexcept
+    {
+        if constexpr (enabled)
+        {
+            Detail::Counters<T>::allocations.fetch_add(1, std::memory_order_relaxed);
+            Detail::Counters<T>::bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    // always zero when instrumentation is disabled
+    template <typename T>
+    Snapshot snapshot() noexcept
+    {
+        Snapshot result;
+
+        if constexpr (enabled)
+        {
+            using Counters = Detail::Counters<T>;
+            result.copy_constructions = Counters::events[static_cast<size_t>(Event::copy_construction)].load(std::memory_order_relaxed);
+            result.move_constructions = Counters::events[static_cast<size_t>(Event::move_construction)].load(std::memory_order_relaxed);
+            result.copy_assignments = Counters::events[static_cast<size_t>(Event::copy_assignment)].load(std::memory_order_relaxed);
+            result.move_assignments = Counters::events[static_cast<size_t>(Event::move_assignment)].load(std::memory_order_relaxed);
+            result.allocations = Counters::allocations.load(std::memory_order_relaxed);
+            result.bytes = Counters::bytes.load(std::memory_order_relaxed);
+        }
+
+        return result;
+    }
+
+    // member that counts copies & moves of the owner without user provided special functions
+#ifdef ENABLE_INSTRUMENTATION
+    template <typename TOwner>
+    struct Tracked
+    {
+        Tracked() = default;
+
+        Tracked(const Tracked&) noexcept
+        {
+            record<TOwner>(Event::copy_construction);
+        }
+
+        Tracked(Tracked&&) noexcept
+        {
+            record<TOwner>(Event::move_construction);
+        }
+
+        Tracked& operator=(const Tracked&) noexcept
+        {
+            record<TOwner>(Event::copy_assignment);
+            return *this;
+        }
+
+        Tracked& operator=(Tracked&&) noexcept
+        {
+            record<TOwner>(Event::move_assignment);
+            return *this;
+        }
+    };
+#else
+    template <typename TOwner>
+    struct Tracked
+    {
+    };
+#endif
+}
+
+#endif
@@ -0,0 +1,151 @@
+#include "catch.hpp"
+#include "data_kernels.hpp"
+#include "mapped_data.hpp"
+
+#ifdef MAPPED_DATA_SUPPORTED
+
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+    // file with unique name in temp directory - removed by destructor (also when REQUIRE fails)
+    class TempFile
+    {
+        std::string path_;
+
+    public:
+        TempFile(const std::string& prefix, const std::vector<int>& items)
+        {
+            std::string path_template = (std::filesystem::temp_directory_path() / (prefix + "-XXXXXX")).string();
+            const int fd = ::mkstemp(path_template.data());
+            if (fd == -1)
+                throw std::system_error(errno, std::generic_category(), "mkstemp failed");
+            ::close(fd);
+            path_ = std::move(path_template);
+
+            std::ofstream out {path_, std::ios::binary | std::ios::trunc};
+            out.write(reinterpret_cast<const char*>(items.data()), items.size() * sizeof(int));
+        }
+
+        TempFile(const TempFile&) = delete;
+        TempFile& operator=(const TempFile&) = delete;
+
+        ~TempFile()
+        {
+            std::error_code ec;
+            std::filesystem::remove(path_, ec);
+        }
+
+        const std::string& path() const noexcept
+        {
+            return path_;
+        }
+    };
+
+    std::vector<int> read_items(const std::string& path)
+    {
+        std::ifstream in {path, std::ios::binary | std::ios::ate};
+        std::vector<int> items(static_cast<size_t>(in.tellg()) / sizeof(int));
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(items.data()), items.size() * sizeof(int));
+
+        return items;
+    }
+}
+
+namespace
+{
+    template <typename TMappedData>
+    constexpr bool has_writable_items = requires(TMappedData& ds) { *ds.begin() = 1; };
+}
+
+static_assert(!has_writable_items<MappedData>, "read-only mapping gives only const access to items");
+static_assert(has_writable_items<MutableMappedData>);
+
+TEST_CASE("MappedData")
+{
+    const std::vector<int> items = {1, 2, 53, 45, 645, 75647, 7561, 2, 3, 4, 5};
+    const TempFile file {"mapped_data_test", items};
+    const std::string& path = file.path();
+
+    SECTION("read-only mapping")
+    {
+        const MappedData ds = MappedData::open(path);
+
+        REQUIRE(ds.name() == path);
+        REQUIRE(std::vector<int>(ds.begin(), ds.end()) == items);
+        ds.advise(MappedData::Access::sequential);
+    }
+
+    SECTION("private writable mapping does not change file")
+    {
+        MutableMappedData ds = MutableMappedData::open(path);
+        ds.advise(MutableMappedData::Access::random);
+
+        for (int& item : ds)
+            item *= 2;
+
+        REQUIRE(*ds.begin() == 2);
+        REQUIRE(read_items(path) == items);
+    }
+
+    SECTION("move transfers ownership of mapping")
+    {
+        MappedData ds = MappedData::open(path);
+        const int* mapped_items = ds.begin();
+
+        MappedData target = std::move(ds);
+
+        REQUIRE(target.begin() == mapped_items);
+        REQUIRE(ds.begin() == nullptr);
+        REQUIRE(ds.size() == 0);
+
+        ds = std::move(target);
+        REQUIRE(ds.begin() == mapped_items);
+    }
+
+    SECTION("empty file")
+    {
+        const TempFile empty_file {"mapped_data_empty", {}};
+        const MappedData ds = MappedData::open(empty_file.path());
+
+        REQUIRE(ds.begin() == ds.end());
+        ds.advise(MappedData::Access::will_need);
+    }
+
+    SECTION("missing file")
+    {
+        REQUIRE_THROWS_AS(MappedData::open(path + ".missing"), std::system_error);
+    }
+}
+
+TEST_CASE("MappedData - scan of file", "[.][benchmark]")
+{
+    std::vector<int> items(16 * 1024 * 1024);
+    std::iota(items.begin(), items.end(), 0);
+    const TempFile file {"mapped_data_bench", items};
+    const std::string& path = file.path();
+    items.clear();
+    items.shrink_to_fit();
+
+    BENCHMARK("std::ifstream into std::vector<int>")
+    {
+        return DataKernels::sum(read_items(path));
+    };
+
+    BENCHMARK("MappedData - sequential")
+    {
+        const MappedData ds = MappedData::open(path);
+        ds.advise(MappedData::Access::sequential);
+        return DataKernels::sum(ds);
+    };
+}
+
+#endif
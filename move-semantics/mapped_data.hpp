@@ -0,0 +1,207 @@
+#ifndef MAPPED_DATA_HPP
+#define MAPPED_DATA_HPP
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_DATA_SUPPORTED 1
+
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+enum class MappingMode
+{
+    read_only,       // items are accessible only through const iterators (pages are mapped without PROT_WRITE)
+    private_writable // changes are visible only in this mapping (copy-on-write pages)
+};
+
+////////////////////////////////////////////////////////////////////////////
+// BasicMappedData - Data which items are mapped (mmap) from a binary file of ints
+//                   move-only - moving transfers ownership of the mapping
+//                   MappedData - read-only, MutableMappedData - private writable mapping
+
+template <MappingMode TMode>
+class BasicMappedData
+{
+public:
+    using Mode = MappingMode;
+    static constexpr Mode mode = TMode;
+
+    enum class Access
+    {
+        normal,
+        sequential,
+        random,
+        will_need
+    };
+
+private:
+    std::string name_;
+    int* data_;
+    size_t size_;
+
+    BasicMappedData(std::string name, int* data, size_t size) noexcept
+        : name_ {std::move(name)}
+        , data_ {data}
+        , size_ {size}
+    {
+    }
+
+    [[noreturn]] static void throw_system_error(const std::string& what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+public:
+    using iterator = std::conditional_t<TMode == Mode::read_only, const int*, int*>;
+    using const_iterator = const int*;
+
+    static BasicMappedData open(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+            throw_system_error("open " + path);
+
+        struct stat file_stat;
+        if (::fstat(fd, &file_stat) == -1)
+        {
+            const int error = errno;
+            ::close(fd);
+            errno = error;
+            throw_system_error("fstat " + path);
+        }
+
+        const size_t length = static_cast<size_t>(file_stat.st_size);
+        if (length % sizeof(int) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("size of " + path + " is not a multiple of sizeof(int)");
+        }
+
+        if (length == 0)
+        {
+            ::close(fd);
+            return BasicMappedData {path, nullptr, 0};
+        }
+
+        const int protection = TMode == Mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+        void* mem = ::mmap(nullptr, length, protection, MAP_PRIVATE, fd, 0);
+        const int error = errno;
+        ::close(fd); // mapping stays valid after closing the descriptor
+
+        if (mem == MAP_FAILED)
+        {
+            errno = error;
+            throw_system_error("mmap " + path);
+        }
+
+        return BasicMappedData {path, static_cast<int*>(mem), length / sizeof(int)};
+    }
+
+    BasicMappedData(const BasicMappedData&) = delete;
+    BasicMappedData& operator=(const BasicMappedData&) = delete;
+
+    BasicMappedData(BasicMappedData&& other) noexcept
+        : name_ {std::move(other.name_)}
+        , data_ {std::exchange(other.data_, nullptr)}
+        , size_ {std::exchange(other.size_, 0)}
+    {
+    }
+
+    BasicMappedData& operator=(BasicMappedData&& other) noexcept
+    {
+        if (this != &other)
+        {
+            BasicMappedData temp(std::move(other));
+            swap(temp);
+        }
+
+        return *this;
+    }
+
+    ~BasicMappedData() noexcept
+    {
+        if (data_)
+            ::munmap(data_, size_ * sizeof(int));
+    }
+
+    void swap(BasicMappedData& other) noexcept
+    {
+        name_.swap(other.name_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+
+    // hint for the kernel how the pages will be accessed
+    void advise(Access access) const
+    {
+        if (!data_)
+            return;
+
+        int advice = MADV_NORMAL;
+        switch (access)
+        {
+            case Access::sequential:
+                advice = MADV_SEQUENTIAL;
+                break;
+            case Access::random:
+                advice = MADV_RANDOM;
+                break;
+            case Access::will_need:
+                advice = MADV_WILLNEED;
+                break;
+            default:
+                break;
+        }
+
+        if (::madvise(data_, size_ * sizeof(int), advice) == -1)
+            throw_system_error("madvise " + name_);
+    }
+
+    const std::string& name() const noexcept
+    {
+        return name_;
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    // writable items only in private writable mapping - read-only mapping has only const begin() & end()
+    iterator begin() noexcept
+        requires(TMode == Mode::private_writable)
+    {
+        return data_;
+    }
+
+    iterator end() noexcept
+        requires(TMode == Mode::private_writable)
+    {
+        return data_ + size_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return data_;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return data_ + size_;
+    }
+};
+
+using MappedData = BasicMappedData<MappingMode::read_only>;
+using MutableMappedData = BasicMappedData<MappingMode::private_writable>;
+
+#endif
+
+#endif
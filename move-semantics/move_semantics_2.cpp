@@ -1,79 +1,11 @@
 #include "catch.hpp"
 #include "gadget.hpp"
+#include "id_generator.hpp"
+#include "instrumentation.hpp"
+#include "unique_ptr.hpp"
 #include <memory>
 #include <string>
 
-template <typename T>
-class UniquePtr
-{
-    T* ptr_;
-
-public:
-    UniquePtr(nullptr_t) noexcept
-        : ptr_ {nullptr}
-    {
-    }
-
-    UniquePtr() noexcept
-        : ptr_ {nullptr}
-    {
-    }
-
-    explicit UniquePtr(T* ptr) noexcept
-        : ptr_ {ptr}
-    {
-    }
-
-    UniquePtr(const UniquePtr&) = delete;
-    UniquePtr& operator=(const UniquePtr&) = delete;
-
-    // move constructor
-    UniquePtr(UniquePtr&& other) noexcept
-        : ptr_ {other.ptr_}
-    {
-        other.ptr_ = nullptr;
-    }
-
-    // move assignment
-    UniquePtr& operator=(UniquePtr&& other) noexcept
-    {
-        if (this != &other)
-        {
-            delete this->ptr_;
-
-            this->ptr_ = other.ptr_;
-            other.ptr_ = nullptr;
-        }
-
-        return *this;
-    }
-
-    ~UniquePtr() noexcept
-    {
-        delete ptr_;
-    }
-
-    explicit operator bool() const
-    {
-        return ptr_ != nullptr;
-    }
-
-    T* get() const
-    {
-        return ptr_;
-    }
-
-    T* operator->() const
-    {
-        return ptr_;
-    }
-
-    T& operator*() const
-    {
-        return ptr_;
-    }
-};
-
 // template <typename T, typename TArg1>
 // UniquePtr<T> MakeUnique(TArg1&& arg1)
 // {
@@ -86,12 +18,6 @@ public:
 //     return UniquePtr<T>(new T(std::forward<TArg1>(arg1), std::forward<TArg2>(arg2)));
 // }
 
-template <typename T, typename... TArgs>
-UniquePtr<T> MakeUnique(TArgs&&... args)
-{
-    return UniquePtr<T>(new T(std::forward<TArgs>(args)...));
-}
-
 TEST_CASE("2---")
 {
     std::cout << "\n--------------------------\n\n";
@@ -99,10 +25,10 @@ TEST_CASE("2---")
 
 UniquePtr<Gadget> create_gadget()
 {
-    static int gen_id {};
+    static IdGenerator gen_id;
 
-    const int id = ++gen_id;
-    return UniquePtr<Gadget> {new Gadget {id, "Gadget-" + std::to_string(id)}};
+    const int id = gen_id.next();
+    return MakeUnique<Gadget>(id, "Gadget-" + std::to_string(id));
 }
 
 void use(UniquePtr<Gadget> g)
@@ -144,6 +70,48 @@ TEST_CASE("move semantics - UniquePtr")
     pg4->use();
 }
 
+namespace
+{
+    struct UntrackedGadget
+    {
+        int id;
+        std::string name;
+    };
+
+    static_assert(Instrumentation::enabled || sizeof(Gadget) == sizeof(UntrackedGadget), "Tracked member compiles to nothing");
+}
+
+TEST_CASE("move semantics - counting moves of UniquePtr & Gadget")
+{
+    const auto ptr_start = Instrumentation::snapshot<UniquePtr<Gadget>>();
+    const auto gadget_start = Instrumentation::snapshot<Gadget>();
+
+    std::vector<UniquePtr<Gadget>> gadgets;
+    for (int i = 0; i < 5; ++i)
+        gadgets.push_back(create_gadget());
+
+    std::vector<Gadget> copies;
+    size_t reallocation_moves = 0; // growth of vector is implementation defined
+    for (const auto& g : gadgets)
+    {
+        if (copies.size() == copies.capacity())
+            reallocation_moves += copies.size();
+        copies.push_back(*g);
+    }
+
+    const auto ptr_stats = Instrumentation::snapshot<UniquePtr<Gadget>>() - ptr_start;
+    const auto gadget_stats = Instrumentation::snapshot<Gadget>() - gadget_start;
+
+    if (Instrumentation::enabled)
+    {
+        REQUIRE(ptr_stats.allocations == 5);
+        REQUIRE(ptr_stats.bytes == 5 * sizeof(Gadget));
+        REQUIRE(ptr_stats.move_constructions >= 5);
+        REQUIRE(gadget_stats.copy_constructions == 5);
+        REQUIRE(gadget_stats.move_constructions == reallocation_moves);
+    }
+}
+
 TEST_CASE("Do not use after move")
 {
     std::vector<int> vec = {1, 2, 3, 4};
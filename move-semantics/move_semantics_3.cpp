@@ -1,158 +1,8 @@
 #include "catch.hpp"
+#include "data.hpp"
 #include "gadget.hpp"
+#include "queue.hpp"
 #include <iostream>
-#include <deque>
-
-////////////////////////////////////////////////////////////////////////////
-// Data - class with copy & move semantics (user provided implementation)
-
-class Data
-{
-    std::string name_;
-    int* data_;
-    size_t size_;
-
-public:
-    using iterator = int*;
-    using const_iterator = const int*;
-
-    Data(std::string name, std::initializer_list<int> list)
-        : name_ {std::move(name)}
-        , data_ {new int[list.size()]}
-        , size_ {list.size()}
-    {
-        std::copy(list.begin(), list.end(), data_);
-
-        std::cout << "Data(" << name_ << ")\n";
-    }
-
-    Data(const Data& other)
-        : name_(other.name_)
-        , data_ {new int[other.size_]}
-        , size_(other.size_)
-    {
-        std::copy(other.begin(), other.end(), data_);
-
-        std::cout << "Data(" << name_ << ": cc)\n";
-    }
-
-    Data& operator=(const Data& other)
-    {
-        Data temp(other);
-        swap(temp);
-
-        std::cout << "Data=(" << name_ << ": cc)\n";
-
-        return *this;
-    }
-
-    /////////////////////////////////////////////////
-    // move constructor
-    Data(Data&& other) noexcept
-        : name_ {std::move(other.name_)}
-        , data_ {other.data_}
-        , size_ {other.size_}
-    {
-        other.data_ = nullptr;
-        other.size_ = 0;
-
-        std::cout << "Data(" << name_ << ": mv)\n";
-    }
-
-    /////////////////////////////////////////////////
-    // move assignment
-    Data& operator=(Data&& other)
-    {
-        if (this != &other)
-        {
-            Data temp(std::move(other));
-            swap(temp);
-        }
-
-        std::cout << "Data=(" << name_ << ": mv)\n";
-
-        return *this;
-    }
-
-    ~Data() noexcept
-    {
-        delete[] data_;
-    }
-
-    void swap(Data& other)
-    {
-        name_.swap(other.name_);
-        std::swap(data_, other.data_);
-        std::swap(size_, other.size_);
-    }
-
-    iterator begin() noexcept
-    {
-        return data_;
-    }
-
-    iterator end() noexcept
-    {
-        return data_ + size_;
-    }
-
-    const_iterator begin() const noexcept
-    {
-        return data_;
-    }
-
-    const_iterator end() const noexcept
-    {
-        return data_ + size_;
-    }
-};
-
-namespace ModernCpp
-{
-    class Data
-    {
-        std::string name_;
-        std::vector<int> data_;
-
-    public:
-        using iterator = std::vector<int>::iterator;
-        using const_iterator = std::vector<int>::const_iterator;
-
-        Data(std::string name, std::initializer_list<int> list)
-            : name_ {std::move(name)}
-            , data_ {list}
-        {
-            std::cout << "Data(" << name_ << ")\n";
-        }
-
-        void swap(Data& other)
-        {
-            name_.swap(other.name_);
-            data_.swap(other.data_);
-        }
-
-        iterator begin()
-        {
-            return data_.begin();
-        }
-
-        iterator end()
-        {
-            return data_.end();
-        }
-
-        const_iterator begin() const
-        {
-            return data_.begin();
-        }
-
-        const_iterator end() const
-        {
-            return data_.end();
-        }
-    };
-
-}
 
 Data create_data_set()
 {
@@ -244,14 +94,52 @@ TEST_CASE("noexcept")
 
     std::vector<Data> vec;
 
-    vec.push_back(Data {"ds1", {1, 2, 3}});
-    std::cout << "---\n";
-    vec.push_back(Data {"ds2", {1, 2, 3}});
-    std::cout << "---\n";
-    vec.push_back(Data {"ds3", {1, 2, 3}});
-    std::cout << "---\n";
-    vec.push_back(Data {"ds4", {1, 2, 3}});
-    std::cout << "---\n";
+    const auto start = Instrumentation::snapshot<Data>();
+
+    size_t reallocation_moves = 0; // growth of vector is implementation defined
+    auto push_back = [&vec, &reallocation_moves](Data&& ds) {
+        if (vec.size() == vec.capacity())
+            reallocation_moves += vec.size();
+        vec.push_back(std::move(ds));
+        std::cout << "---\n";
+    };
+
+    push_back(Data {"ds1", {1, 2, 3}});
+    push_back(Data {"ds2", {1, 2, 3}});
+    push_back(Data {"ds3", {1, 2, 3}});
+    push_back(Data {"ds4", {1, 2, 3}});
+
+    const auto stats = Instrumentation::snapshot<Data>() - start;
+
+    if (Instrumentation::enabled)
+    {
+        REQUIRE(stats.copies() == 0); // move constructor is noexcept - reallocation moves items
+        REQUIRE(stats.move_constructions == 4 + reallocation_moves);
+        REQUIRE(stats.allocations == 4);
+        REQUIRE(stats.bytes == 4 * 3 * sizeof(int));
+    }
+}
+
+TEST_CASE("Instrumentation - assignment is counted once")
+{
+    Data ds1 {"ds1", {1, 2, 3}};
+    Data ds2 {"ds2", {4, 5}};
+
+    const auto start = Instrumentation::snapshot<Data>();
+
+    ds1 = ds2;
+    ds2 = std::move(ds1);
+
+    const auto stats = Instrumentation::snapshot<Data>() - start;
+
+    if (Instrumentation::enabled)
+    {
+        REQUIRE(stats.copies() == 1);
+        REQUIRE(stats.copy_assignments == 1);
+        REQUIRE(stats.moves() == 1);
+        REQUIRE(stats.move_assignments == 1);
+        REQUIRE(stats.allocations == 1);
+    }
 }
 
 template <typename T>
@@ -349,46 +237,6 @@ TEST_CASE("perfect forwarding")
     use(Gadget {3});
 }
 
-template <typename T>
-class Queue
-{
-    std::deque<T> q_;
-public:
-    Queue() = default;
-
-    void push(const T& item)
-    {
-        q_.push_front(item);
-    }
-
-    void push(T&& item)
-    {
-        q_.push_front(std::move(item));
-    }
-
-    // template <typename TItem>
-    // void push(TItem&& item)
-    // {
-    //     q_.push_front(std::forward<TItem>(item));
-    // }
-
-    template <typename TArg1, typename TArg2>
-    void emplace(TArg1&& arg1, TArg2&& arg2)
-    {
-        q_.emplace_front(std::forward<TArg1>(arg1), std::forward<TArg2>(arg2));
-    }
-
-    T& front()
-    {   
-        return q_.back();
-    }
-
-    void pop()
-    {
-        q_.pop_back();
-    }
-};
-
 TEST_CASE("Queue")
 {
     Queue<std::string> q;
@@ -0,0 +1,222 @@
+#include "catch.hpp"
+#include "mpmc_queue.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+TEST_CASE("MpmcQueue - single thread")
+{
+    MpmcQueue<std::unique_ptr<int>> q;
+
+    REQUIRE(q.push(std::make_unique<int>(1)));
+    REQUIRE(q.push(std::make_unique<int>(2)));
+    REQUIRE(q.size() == 2);
+
+    REQUIRE(**q.pop() == 1);
+    REQUIRE(**q.try_pop() == 2);
+    REQUIRE_FALSE(q.try_pop().has_value());
+
+    SECTION("pop_for times out when empty")
+    {
+        REQUIRE_FALSE(q.pop_for(1ms).has_value());
+    }
+
+    SECTION("pop_batch takes up to out.size() items")
+    {
+        for (int i = 0; i < 5; ++i)
+            q.push(std::make_unique<int>(i));
+
+        std::array<std::unique_ptr<int>, 3> batch;
+        REQUIRE(q.pop_batch(batch) == 3);
+        REQUIRE(*batch[2] == 2);
+        REQUIRE(q.pop_batch(batch) == 2);
+        REQUIRE(*batch[1] == 4);
+    }
+
+    SECTION("closed queue is drained & rejects new items")
+    {
+        q.push(std::make_unique<int>(3));
+        q.close();
+
+        REQUIRE(q.is_closed());
+        REQUIRE_FALSE(q.push(std::make_unique<int>(4)));
+        REQUIRE(**q.pop() == 3);
+        REQUIRE_FALSE(q.pop().has_value());
+        REQUIRE_FALSE(q.pop_for(1s).has_value());
+    }
+}
+
+TEST_CASE("MpmcQueue - close wakes all waiting consumers")
+{
+    MpmcQueue<int> q;
+
+    std::vector<std::thread> consumers;
+    std::atomic<int> finished {};
+    for (int i = 0; i < 4; ++i)
+        consumers.emplace_back([&] {
+            while (q.pop())
+                ;
+            ++finished;
+        });
+
+    q.push(1);
+    q.close();
+
+    for (auto& consumer : consumers)
+        consumer.join();
+
+    REQUIRE(finished == 4);
+}
+
+TEST_CASE("MpmcQueue - many producers & consumers")
+{
+    const int producers_count = 4;
+    const int consumers_count = 4;
+    const int items_per_producer = 10'000;
+
+    MpmcQueue<int> q;
+    std::vector<long long> sums(consumers_count);
+
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < consumers_count; ++c)
+        consumers.emplace_back([&q, &sum = sums[c]] {
+            std::array<int, 16> batch;
+            while (size_t count = q.pop_batch(batch))
+                sum = std::accumulate(batch.begin(), batch.begin() + count, sum);
+        });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producers_count; ++p)
+        producers.emplace_back([&q] {
+            for (int i = 1; i <= items_per_producer; ++i)
+                q.push(i);
+        });
+
+    for (auto& producer : producers)
+        producer.join();
+    q.close();
+    for (auto& consumer : consumers)
+        consumer.join();
+
+    const long long expected = producers_count * (items_per_producer * (items_per_producer + 1LL) / 2);
+    REQUIRE(std::accumulate(sums.begin(), sums.end(), 0LL) == expected);
+}
+
+namespace
+{
+    // naive work queue - std::deque guarded by mutex, one item per lock acquisition
+    class DequeWorkQueue
+    {
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::deque<int> items_;
+        bool is_closed_ {};
+
+    public:
+        void push(int item)
+        {
+            {
+                std::lock_guard lk {mtx_};
+                items_.push_back(item);
+            }
+            cv_.notify_one();
+        }
+
+        std::optional<int> pop()
+        {
+            std::unique_lock lk {mtx_};
+            cv_.wait(lk, [this] { return !items_.empty() || is_closed_; });
+            if (items_.empty())
+                return std::nullopt;
+
+            int item = items_.front();
+            items_.pop_front();
+            return item;
+        }
+
+        void close()
+        {
+            {
+                std::lock_guard lk {mtx_};
+                is_closed_ = true;
+            }
+            cv_.notify_all();
+        }
+    };
+
+    // runs threads_count producers & threads_count consumers - returns items/s
+    template <typename TQueue, typename TConsume>
+    double measure_throughput(int threads_count, int items_count, TConsume consume)
+    {
+        TQueue q;
+        std::atomic<long long> consumed {};
+
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> consumers;
+        for (int i = 0; i < threads_count; ++i)
+            consumers.emplace_back([&] { consumed += consume(q); });
+
+        std::vector<std::thread> producers;
+        for (int i = 0; i < threads_count; ++i)
+            producers.emplace_back([&q, count = items_count / threads_count] {
+                for (int item = 0; item < count; ++item)
+                    q.push(item);
+            });
+
+        for (auto& producer : producers)
+            producer.join();
+        q.close();
+        for (auto& consumer : consumers)
+            consumer.join();
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        return consumed / elapsed.count();
+    }
+}
+
+TEST_CASE("MpmcQueue vs. mutex + std::deque - scaling", "[.][benchmark]")
+{
+    const int items_count = 1'000'000;
+
+    auto pop_each = [](auto& q) {
+        long long count = 0;
+        while (q.pop())
+            ++count;
+        return count;
+    };
+
+    auto pop_batches = [](MpmcQueue<int>& q) {
+        long long count = 0;
+        std::array<int, 64> batch;
+        while (size_t popped = q.pop_batch(batch))
+            count += popped;
+        return count;
+    };
+
+    std::cout << "threads (producers = consumers) | mutex + std::deque | MpmcQueue::pop | MpmcQueue::pop_batch [items/s]\n";
+    for (int threads_count = 1; threads_count <= 32; threads_count *= 2)
+    {
+        const auto deque_throughput = measure_throughput<DequeWorkQueue>(threads_count, items_count, pop_each);
+        const auto pop_throughput = measure_throughput<MpmcQueue<int>>(threads_count, items_count, pop_each);
+        const auto batch_throughput = measure_throughput<MpmcQueue<int>>(threads_count, items_count, pop_batches);
+
+        std::cout << threads_count << " | " << static_cast<long long>(deque_throughput)
+                  << " | " << static_cast<long long>(pop_throughput)
+                  << " | " << static_cast<long long>(batch_throughput) << "\n";
+    }
+}
@@ -0,0 +1,129 @@
+#ifndef MPMC_QUEUE_HPP
+#define MPMC_QUEUE_HPP
+
+#include "queue.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////
+// MpmcQueue - blocking multi-producer/multi-consumer queue (Queue<T> guarded by mutex)
+//             close() rejects new items and wakes all waiting consumers,
+//             items pushed before close() can still be popped
+
+template <typename T>
+class MpmcQueue
+{
+    mutable std::mutex mtx_;
+    std::condition_variable cv_not_empty_;
+    Queue<T> items_;
+    bool is_closed_ {};
+
+    T take_front()
+    {
+        T item = std::move(items_.front());
+        items_.pop();
+        return item;
+    }
+
+public:
+    using value_type = T;
+
+    MpmcQueue() = default;
+
+    explicit MpmcQueue(size_t capacity)
+        : items_ {capacity}
+    {
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // returns false if queue is closed
+    template <typename TItem>
+    bool push(TItem&& item)
+    {
+        {
+            std::lock_guard lk {mtx_};
+            if (is_closed_)
+                return false;
+            items_.push(std::forward<TItem>(item));
+        }
+
+        cv_not_empty_.notify_one();
+        return true;
+    }
+
+    // blocks until item is available - returns std::nullopt if queue is closed & empty
+    std::optional<T> pop()
+    {
+        std::unique_lock lk {mtx_};
+        cv_not_empty_.wait(lk, [this] { return !items_.empty() || is_closed_; });
+
+        if (items_.empty())
+            return std::nullopt;
+
+        return take_front();
+    }
+
+    // returns std::nullopt on timeout or if queue is closed & empty
+    template <typename TRep, typename TPeriod>
+    std::optional<T> pop_for(std::chrono::duration<TRep, TPeriod> timeout)
+    {
+        std::unique_lock lk {mtx_};
+        if (!cv_not_empty_.wait_for(lk, timeout, [this] { return !items_.empty() || is_closed_; }))
+            return std::nullopt;
+
+        if (items_.empty())
+            return std::nullopt;
+
+        return take_front();
+    }
+
+    std::optional<T> try_pop()
+    {
+        std::lock_guard lk {mtx_};
+        if (items_.empty())
+            return std::nullopt;
+
+        return take_front();
+    }
+
+    // blocks until at least one item is available, then moves up to out.size() items
+    // into out under single lock - returns number of popped items (0 if queue is closed & empty)
+    size_t pop_batch(std::span<T> out)
+    {
+        std::unique_lock lk {mtx_};
+        cv_not_empty_.wait(lk, [this] { return !items_.empty() || is_closed_; });
+
+        return items_.pop_bulk(out);
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard lk {mtx_};
+            is_closed_ = true;
+        }
+
+        cv_not_empty_.notify_all();
+    }
+
+    bool is_closed() const
+    {
+        std::lock_guard lk {mtx_};
+        return is_closed_;
+    }
+
+    size_t size() const
+    {
+        std::lock_guard lk {mtx_};
+        return items_.size();
+    }
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include "catch.hpp"
+#include "gadget.hpp"
+#include "object_pool.hpp"
+#include "spsc_queue.hpp"
+#include "unique_ptr.hpp"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static_assert(sizeof(PooledPtr<Gadget>) == sizeof(Gadget*));
+
+TEST_CASE("MakePooledUnique - storage is reused")
+{
+    auto& pool = ObjectPool<Gadget>::local();
+
+    PooledPtr<Gadget> g1 = MakePooledUnique<Gadget>(1, "ipad");
+    REQUIRE(g1->name == "ipad");
+
+    Gadget* address = g1.get();
+    g1.reset();
+
+    PooledPtr<Gadget> g2 = MakePooledUnique<Gadget>(2, "ipod");
+    REQUIRE(g2.get() == address);
+    REQUIRE((*g2).id == 2);
+
+    SECTION("chunks are added on demand")
+    {
+        const size_t chunks_before = pool.chunks_count();
+
+        std::vector<PooledPtr<Gadget>> gadgets;
+        for (int i = 0; i < 10'000; ++i)
+            gadgets.push_back(MakePooledUnique<Gadget>(i));
+
+        REQUIRE(pool.chunks_count() > chunks_before);
+
+        const size_t chunks_used = pool.chunks_count();
+        gadgets.clear();
+        for (int i = 0; i < 10'000; ++i)
+            gadgets.push_back(MakePooledUnique<Gadget>(i));
+
+        REQUIRE(pool.chunks_count() == chunks_used);
+    }
+}
+
+TEST_CASE("MakePooledUnique - cross-thread frees are returned to owner")
+{
+    auto& pool = ObjectPool<std::string>::local();
+
+    std::vector<PooledPtr<std::string>> items;
+    for (int i = 0; i < 1000; ++i)
+        items.push_back(MakePooledUnique<std::string>(std::to_string(i)));
+
+    const size_t chunks_used = pool.chunks_count();
+
+    std::thread consumer {[items = std::move(items)]() mutable {
+        items.clear(); // batches are flushed at thread exit at the latest
+    }};
+    consumer.join();
+
+    for (int i = 0; i < 1000; ++i)
+        items.push_back(MakePooledUnique<std::string>(std::to_string(i)));
+
+    REQUIRE(pool.chunks_count() == chunks_used);
+    REQUIRE(*items.back() == "999");
+}
+
+TEST_CASE("MakePooledUnique - pool of exited thread is adopted")
+{
+    PooledPtr<int> survivor;
+    std::thread producer {[&survivor] { survivor = MakePooledUnique<int>(42); }};
+    producer.join();
+
+    // released to orphaned pool
+    survivor.reset();
+
+    size_t chunks_count {};
+    std::thread adopter {[&chunks_count] {
+        PooledPtr<int> item = MakePooledUnique<int>(665);
+        chunks_count = ObjectPool<int>::local().chunks_count();
+    }};
+    adopter.join();
+
+    REQUIRE(chunks_count == 1);
+}
+
+TEST_CASE("MakePooledUnique vs. MakeUnique - churn", "[.][benchmark]")
+{
+    const int live_count = 1'000;
+    const int churn_count = 100'000;
+
+    std::vector<UniquePtr<Gadget>> gadgets(live_count);
+    std::vector<PooledPtr<Gadget>> pooled_gadgets(live_count);
+
+    BENCHMARK("MakeUnique - new/delete")
+    {
+        std::cout.setstate(std::ios::failbit); // silence Gadget traces
+        for (int i = 0; i < churn_count; ++i)
+            gadgets[i % live_count] = MakeUnique<Gadget>(i);
+        std::cout.clear();
+        return gadgets.back().get();
+    };
+
+    BENCHMARK("MakePooledUnique - pool")
+    {
+        std::cout.setstate(std::ios::failbit);
+        for (int i = 0; i < churn_count; ++i)
+            pooled_gadgets[i % live_count] = MakePooledUnique<Gadget>(i);
+        std::cout.clear();
+        return pooled_gadgets.back().get();
+    };
+
+    // producer allocates, consumer frees
+    auto cross_thread_churn = [churn_count](auto make_gadget) {
+        SpscQueue<decltype(make_gadget(0))> q {1024};
+
+        std::thread consumer {[&q, churn_count] {
+            decltype(make_gadget(0)) g;
+            for (int i = 0; i < churn_count;)
+            {
+                if (q.try_pop(g))
+                {
+                    g = nullptr;
+                    ++i;
+                }
+                else
+                    std::this_thread::yield();
+            }
+        }};
+
+        for (int i = 0; i < churn_count; ++i)
+            q.push(make_gadget(i));
+
+        consumer.join();
+        return q.size();
+    };
+
+    BENCHMARK("MakeUnique - cross-thread")
+    {
+        std::cout.setstate(std::ios::failbit);
+        auto result = cross_thread_churn([](int id) { return MakeUnique<Gadget>(id); });
+        std::cout.clear();
+        return result;
+    };
+
+    BENCHMARK("MakePooledUnique - cross-thread")
+    {
+        std::cout.setstate(std::ios::failbit);
+        auto result = cross_thread_churn([](int id) { return MakePooledUnique<Gadget>(id); });
+        std::cout.clear();
+        return result;
+    };
+}
@@ -0,0 +1,294 @@
+#ifndef OBJECT_POOL_HPP
+#define OBJECT_POOL_HPP
+
+#include "instrumentation.hpp"
+#include "unique_ptr.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+// ObjectPool<T> - per-type, per-thread free-list of storage for T objects
+//                 storage is carved from chunks aligned to chunk_size, so owning pool
+//                 is found from chunk header of any pointer (deleter stays stateless)
+//                 frees from other threads are collected in batches and pushed
+//                 to owner's lock-free list, which owner reclaims when local list is empty
+//                 pool of exited thread with live objects is adopted by next thread needing a pool
+
+template <typename T>
+class ObjectPool
+{
+public:
+    static constexpr size_t chunk_size = 16 * 1024;
+    static constexpr size_t remote_batch_size = 64;
+
+private:
+    union Slot
+    {
+        Slot* next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    struct Chunk
+    {
+        ObjectPool* owner;
+        Chunk* next;
+    };
+
+    static constexpr size_t slots_offset = (sizeof(Chunk) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+    static constexpr size_t slots_per_chunk = (chunk_size - slots_offset) / sizeof(Slot);
+
+    static_assert(slots_per_chunk >= 8, "T is too large for pooling");
+    static_assert(alignof(Slot) <= chunk_size);
+
+    // frees of objects owned by other pool - pushed to owner when batch is full
+    struct RemoteBatch
+    {
+        ObjectPool* owner;
+        Slot* head;
+        Slot* tail;
+        size_t count;
+    };
+
+    Slot* free_list_ {};
+    Chunk* chunks_ {};
+    size_t chunks_count_ {};
+    size_t live_ {}; // allocated by this pool & not returned yet
+    std::vector<RemoteBatch> remote_batches_;
+    alignas(64) std::atomic<Slot*> remote_frees_ {};
+
+    static inline thread_local ObjectPool* current_ {};
+
+    // pools of exited threads with objects still alive
+    static inline std::mutex orphans_mtx_;
+    static inline std::vector<ObjectPool*> orphans_;
+
+    // destroys pool of exiting thread (or hands it over for adoption if its objects are still alive)
+    struct ThreadExit
+    {
+        ~ThreadExit()
+        {
+            ObjectPool* pool = std::exchange(current_, nullptr);
+            if (!pool)
+                return;
+
+            pool->flush_remote_frees();
+            pool->reclaim_remote_frees();
+
+            if (pool->live_ == 0)
+            {
+                delete pool;
+                return;
+            }
+
+            std::lock_guard lk {orphans_mtx_};
+            orphans_.push_back(pool);
+        }
+    };
+
+    ObjectPool() = default;
+
+    ~ObjectPool()
+    {
+        while (chunks_)
+        {
+            Chunk* chunk = std::exchange(chunks_, chunks_->next);
+            ::operator delete(chunk, std::align_val_t {chunk_size});
+        }
+    }
+
+    static Chunk* chunk_of(void* ptr) noexcept
+    {
+        return reinterpret_cast<Chunk*>(reinterpret_cast<std::uintptr_t>(ptr) & ~(chunk_size - 1));
+    }
+
+    void add_chunk()
+    {
+        auto* chunk = static_cast<Chunk*>(::operator new(chunk_size, std::align_val_t {chunk_size}));
+        chunk->owner = this;
+        chunk->next = chunks_;
+        chunks_ = chunk;
+        ++chunks_count_;
+
+        Instrumentation::record_allocation<ObjectPool>(chunk_size);
+
+        auto* slots = reinterpret_cast<Slot*>(reinterpret_cast<std::byte*>(chunk) + slots_offset);
+        for (size_t i = slots_per_chunk; i-- > 0;)
+        {
+            slots[i].next = free_list_;
+            free_list_ = &slots[i];
+        }
+    }
+
+    void push_remote_frees(Slot* head, Slot* tail) noexcept
+    {
+        Slot* old_head = remote_frees_.load(std::memory_order_relaxed);
+        do
+        {
+            tail->next = old_head;
+        } while (!remote_frees_.compare_exchange_weak(old_head, head, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void reclaim_remote_frees() noexcept
+    {
+        Slot* head = remote_frees_.exchange(nullptr, std::memory_order_acquire);
+        while (head)
+        {
+            Slot* next = head->next;
+            head->next = free_list_;
+            free_list_ = head;
+            --live_;
+            head = next;
+        }
+    }
+
+    void defer_remote_free(ObjectPool* owner, Slot* slot) noexcept
+    {
+        auto batch = std::find_if(remote_batches_.begin(), remote_batches_.end(),
+            [owner](const RemoteBatch& b) { return b.owner == owner; });
+
+        if (batch == remote_batches_.end())
+        {
+            try
+            {
+                remote_batches_.push_back(RemoteBatch {owner, nullptr, slot, 0});
+            }
+            catch (...)
+            {
+                owner->push_remote_frees(slot, slot); // no memory for batch - free immediately
+                return;
+            }
+            batch = remote_batches_.end() - 1;
+        }
+
+        slot->next = batch->head;
+        batch->head = slot;
+        if (++batch->count == remote_batch_size)
+        {
+            owner->push_remote_frees(batch->head, batch->tail);
+            remote_batches_.erase(batch);
+        }
+    }
+
+public:
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // pool of calling thread
+    static ObjectPool& local()
+    {
+        if (!current_)
+        {
+            static thread_local ThreadExit thread_exit;
+
+            {
+                std::lock_guard lk {orphans_mtx_};
+                if (!orphans_.empty())
+                {
+                    current_ = orphans_.back();
+                    orphans_.pop_back();
+                }
+            }
+
+            if (!current_)
+                current_ = new ObjectPool();
+        }
+
+        return *current_;
+    }
+
+    // uninitialized storage for one T
+    void* allocate()
+    {
+        if (!free_list_)
+        {
+            reclaim_remote_frees();
+            if (!free_list_)
+                add_chunk();
+        }
+
+        Slot* slot = std::exchange(free_list_, free_list_->next);
+        ++live_;
+
+        return slot->storage;
+    }
+
+    // returns storage to owning pool - may be called from any thread
+    static void deallocate(void* ptr) noexcept
+    {
+        Slot* slot = reinterpret_cast<Slot*>(ptr);
+        ObjectPool* owner = chunk_of(ptr)->owner;
+        ObjectPool* current = current_;
+
+        if (owner == current)
+        {
+            slot->next = current->free_list_;
+            current->free_list_ = slot;
+            --current->live_;
+        }
+        else if (current)
+            current->defer_remote_free(owner, slot);
+        else
+            owner->push_remote_frees(slot, slot);
+    }
+
+    // pushes all pending (not full) batches of frees to their owners
+    void flush_remote_frees() noexcept
+    {
+        for (const auto& batch : remote_batches_)
+            batch.owner->push_remote_frees(batch.head, batch.tail);
+
+        remote_batches_.clear();
+    }
+
+    size_t chunks_count() const noexcept
+    {
+        return chunks_count_;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// PoolDelete - destroys object & returns storage to its ObjectPool
+
+template <typename T>
+struct PoolDelete
+{
+    void operator()(T* ptr) const noexcept
+    {
+        ptr->~T();
+        ObjectPool<T>::deallocate(ptr);
+    }
+};
+
+template <typename T>
+using PooledPtr = UniquePtr<T, PoolDelete<T>>;
+
+////////////////////////////////////////////////////////////////////////////
+// MakePooledUnique<T>(args...) - MakeUnique with storage taken from pool of calling thread
+
+template <typename T, typename... TArgs>
+PooledPtr<T> MakePooledUnique(TArgs&&... args)
+{
+    static_assert(!std::is_array_v<T>, "arrays can't be pooled");
+
+    ObjectPool<T>& pool = ObjectPool<T>::local();
+    void* storage = pool.allocate();
+
+    try
+    {
+        return PooledPtr<T>(new (storage) T(std::forward<TArgs>(args)...));
+    }
+    catch (...)
+    {
+        ObjectPool<T>::deallocate(storage);
+        throw;
+    }
+}
+
+#endif
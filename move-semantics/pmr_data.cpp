@@ -0,0 +1,141 @@
+#include "catch.hpp"
+#include "data.hpp"
+#include <iterator>
+#include <memory_resource>
+#include <vector>
+
+class CountingResource : public std::pmr::memory_resource
+{
+    std::pmr::memory_resource* upstream_;
+
+public:
+    size_t allocations {};
+    size_t deallocations {};
+
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_ {upstream}
+    {
+    }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+    {
+        ++deallocations;
+        upstream_->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+TEST_CASE("Data - memory resource")
+{
+    CountingResource counter;
+    std::pmr::monotonic_buffer_resource arena {&counter};
+
+    Data ds1 {"ds1", {1, 2, 3, 4, 5}, &arena};
+    REQUIRE(ds1.get_allocator().resource() == &arena);
+    REQUIRE(counter.allocations == 1);
+
+    SECTION("move within the same arena steals buffer")
+    {
+        const int* buffer = ds1.begin();
+
+        Data target {std::move(ds1), &arena};
+
+        REQUIRE(target.begin() == buffer);
+        REQUIRE(ds1.begin() == ds1.end());
+    }
+
+    SECTION("move to another arena copies items")
+    {
+        std::pmr::monotonic_buffer_resource other_arena;
+
+        Data target {std::move(ds1), &other_arena};
+
+        REQUIRE(target.get_allocator().resource() == &other_arena);
+        REQUIRE(std::equal(target.begin(), target.end(), ds1.begin(), ds1.end()));
+    }
+
+    SECTION("move assignment across arenas copies items")
+    {
+        Data target {"target", {6, 7}};
+
+        target = std::move(ds1);
+
+        REQUIRE(target.get_allocator().resource() == std::pmr::get_default_resource());
+        REQUIRE(std::vector<int>(target.begin(), target.end()) == std::vector<int> {1, 2, 3, 4, 5});
+    }
+
+    SECTION("copy constructor uses default resource")
+    {
+        Data backup = ds1;
+
+        REQUIRE(backup.get_allocator().resource() == std::pmr::get_default_resource());
+    }
+}
+
+TEST_CASE("pmr::vector<Data> carved from one arena")
+{
+    CountingResource counter;
+
+    {
+        std::pmr::monotonic_buffer_resource arena {64 * 1024, &counter};
+
+        std::pmr::vector<Data> rows {&arena};
+        for (int i = 0; i < 100; ++i)
+            rows.emplace_back("row", std::initializer_list<int> {1, 2, 3, i});
+
+        std::pmr::vector<ModernCpp::Data> modern_rows {&arena};
+        for (int i = 0; i < 100; ++i)
+            modern_rows.emplace_back("row", std::initializer_list<int> {1, 2, 3, i});
+
+        REQUIRE(rows.back().get_allocator().resource() == &arena);
+        REQUIRE(modern_rows.back().get_allocator().resource() == &arena);
+        REQUIRE(*std::prev(rows.back().end()) == 99);
+        REQUIRE(counter.allocations == 1);
+    }
+
+    REQUIRE(counter.deallocations == counter.allocations);
+}
+
+TEST_CASE("pmr::vector<Data> - build & drop", "[.][benchmark]")
+{
+    const int rows_count = 10'000;
+    const std::initializer_list<int> items = {1, 2, 53, 45, 645, 75647, 7561, 2, 3, 4, 5};
+
+    std::vector<char> arena_buffer(rows_count * 256);
+
+    BENCHMARK("std::vector<Data>")
+    {
+        std::cout.setstate(std::ios::failbit); // silence Data traces
+        {
+            std::vector<Data> rows;
+            rows.reserve(rows_count);
+            for (int i = 0; i < rows_count; ++i)
+                rows.emplace_back("ds-large", items);
+        }
+        std::cout.clear();
+    };
+
+    BENCHMARK("std::pmr::vector<Data> - monotonic arena")
+    {
+        std::cout.setstate(std::ios::failbit);
+        {
+            std::pmr::monotonic_buffer_resource arena {arena_buffer.data(), arena_buffer.size()};
+            std::pmr::vector<Data> rows {&arena};
+            rows.reserve(rows_count);
+            for (int i = 0; i < rows_count; ++i)
+                rows.emplace_back("ds-large", items);
+        }
+        std::cout.clear();
+    };
+}
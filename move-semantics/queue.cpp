@@ -0,0 +1,263 @@
+#include "catch.hpp"
+#include "queue.hpp"
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // previous std::deque based implementation of Queue
+    template <typename T>
+    class DequeQueue
+    {
+        std::deque<T> q_;
+
+    public:
+        void push(const T& item)
+        {
+            q_.push_front(item);
+        }
+
+        void push(T&& item)
+        {
+            q_.push_front(std::move(item));
+        }
+
+        T& front()
+        {
+            return q_.back();
+        }
+
+        void pop()
+        {
+            q_.pop_back();
+        }
+    };
+}
+
+TEST_CASE("Queue - FIFO order")
+{
+    Queue<std::string> q;
+
+    q.push("one");
+    q.emplace(3, 'c');
+    q.emplace("three");
+
+    REQUIRE(q.size() == 3);
+    REQUIRE(q.front() == "one");
+    REQUIRE(q.back() == "three");
+
+    q.pop();
+    REQUIRE(q.front() == "ccc");
+}
+
+TEST_CASE("Queue - ring buffer wraps & grows")
+{
+    Queue<std::string> q {4};
+    REQUIRE(q.capacity() == 4);
+
+    for (int i = 0; i < 3; ++i)
+        q.push(std::to_string(i));
+    q.pop();
+    q.pop();
+
+    for (int i = 3; i < 6; ++i)
+        q.push(std::to_string(i)); // wraps around
+    REQUIRE(q.capacity() == 4);
+
+    q.push("6"); // grows
+    REQUIRE(q.capacity() == 8);
+
+    std::vector<std::string> items;
+    for (; !q.empty(); q.pop())
+        items.push_back(q.front());
+
+    REQUIRE(items == std::vector<std::string> {"2", "3", "4", "5", "6"});
+}
+
+TEST_CASE("Queue - fixed capacity")
+{
+    Queue<int> q {2, QueueCapacity::fixed};
+
+    q.push(1);
+    REQUIRE(q.try_push(2));
+    REQUIRE_FALSE(q.try_push(3));
+    REQUIRE_THROWS_AS(q.push(3), std::length_error);
+    REQUIRE(q.size() == 2);
+}
+
+TEST_CASE("Queue - bulk push & pop")
+{
+    Queue<std::string> q {4};
+    const std::vector<std::string> items = {"a", "b", "c", "d", "e"};
+
+    q.push("first");
+    q.pop();
+    q.push_bulk(items);
+    REQUIRE(q.size() == 5);
+
+    std::vector<std::string> out(3);
+    REQUIRE(q.pop_bulk(out) == 3);
+    REQUIRE(out == std::vector<std::string> {"a", "b", "c"});
+    REQUIRE(q.pop_bulk(out) == 2);
+    REQUIRE(out[1] == "e");
+    REQUIRE(q.empty());
+}
+
+TEST_CASE("Queue - move-only items")
+{
+    Queue<std::unique_ptr<int>> q;
+    std::vector<std::unique_ptr<int>> items;
+    items.push_back(std::make_unique<int>(1));
+    items.push_back(std::make_unique<int>(2));
+
+    q.push_bulk(std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+    q.emplace(new int(3));
+
+    Queue<std::unique_ptr<int>> target = std::move(q);
+    REQUIRE(q.empty());
+    REQUIRE(*target.front() == 1);
+    REQUIRE(*target.back() == 3);
+}
+
+TEST_CASE("Queue - item of full queue is pushed")
+{
+    const std::string long_item(100, 'x'); // heap allocated - freed item would be detected by sanitizers
+    Queue<std::string> q {2};
+    q.push(long_item);
+    q.push("second");
+    REQUIRE(q.capacity() == 2);
+
+    q.push(q.front()); // grows - old items are destroyed after the copy is made
+    REQUIRE(q.capacity() == 4);
+    REQUIRE(q.back() == long_item);
+
+    q.push("fourth");
+    q.push_bulk(std::span<const std::string> {&q.front(), 1}); // grows again
+    REQUIRE(q.size() == 5);
+    REQUIRE(q.back() == long_item);
+}
+
+namespace
+{
+    struct ThrowingCopy
+    {
+        static inline int alive = 0;
+        static inline int copies_left = 0;
+
+        ThrowingCopy()
+        {
+            ++alive;
+        }
+
+        ThrowingCopy(const ThrowingCopy&)
+        {
+            if (copies_left-- == 0)
+                throw std::runtime_error("copy failed");
+            ++alive;
+        }
+
+        ~ThrowingCopy()
+        {
+            --alive;
+        }
+    };
+}
+
+TEST_CASE("Queue - copy constructor releases copied items when copy throws")
+{
+    {
+        Queue<ThrowingCopy> q {4};
+        for (int i = 0; i < 3; ++i)
+            q.emplace();
+
+        ThrowingCopy::copies_left = 2;
+        REQUIRE_THROWS_AS(Queue<ThrowingCopy> {q}, std::runtime_error);
+        REQUIRE(ThrowingCopy::alive == 3);
+    }
+
+    REQUIRE(ThrowingCopy::alive == 0);
+}
+
+TEST_CASE("Queue - throughput", "[.][benchmark]")
+{
+    const int batch = 1'000;
+    const std::string text = "payload";
+
+    // queues are reused between samples - steady state without growth
+    DequeQueue<std::string> deque_strings;
+    Queue<std::string> ring_strings {batch};
+    DequeQueue<std::unique_ptr<int>> deque_ptrs;
+    Queue<std::unique_ptr<int>> ring_ptrs {batch};
+    std::vector<std::string> bulk_strings(batch);
+    std::vector<std::unique_ptr<int>> ptrs(batch);
+    for (auto& ptr : ptrs)
+        ptr = std::make_unique<int>(1);
+
+    BENCHMARK("DequeQueue<std::string>")
+    {
+        size_t length = 0;
+        for (int i = 0; i < batch; ++i)
+            deque_strings.push(text);
+        for (int i = 0; i < batch; ++i)
+        {
+            length += deque_strings.front().size();
+            deque_strings.pop();
+        }
+        return length;
+    };
+
+    BENCHMARK("Queue<std::string>")
+    {
+        size_t length = 0;
+        for (int i = 0; i < batch; ++i)
+            ring_strings.push(text);
+        for (int i = 0; i < batch; ++i)
+        {
+            length += ring_strings.front().size();
+            ring_strings.pop();
+        }
+        return length;
+    };
+
+    BENCHMARK("Queue<std::string> - bulk")
+    {
+        std::fill(bulk_strings.begin(), bulk_strings.end(), text);
+        ring_strings.push_bulk(bulk_strings);
+        return ring_strings.pop_bulk(bulk_strings);
+    };
+
+    BENCHMARK("DequeQueue<std::unique_ptr<int>>")
+    {
+        for (auto& ptr : ptrs)
+            deque_ptrs.push(std::move(ptr));
+        for (auto& ptr : ptrs)
+        {
+            ptr = std::move(deque_ptrs.front());
+            deque_ptrs.pop();
+        }
+        return ptrs.back().get();
+    };
+
+    BENCHMARK("Queue<std::unique_ptr<int>>")
+    {
+        for (auto& ptr : ptrs)
+            ring_ptrs.push(std::move(ptr));
+        for (auto& ptr : ptrs)
+        {
+            ptr = std::move(ring_ptrs.front());
+            ring_ptrs.pop();
+        }
+        return ptrs.back().get();
+    };
+
+    BENCHMARK("Queue<std::unique_ptr<int>> - bulk")
+    {
+        ring_ptrs.push_bulk(std::make_move_iterator(ptrs.begin()), std::make_move_iterator(ptrs.end()));
+        return ring_ptrs.pop_bulk(ptrs);
+    };
+}
@@ -0,0 +1,324 @@
+#ifndef QUEUE_HPP
+#define QUEUE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////
+// Queue - FIFO queue stored in contiguous ring buffer (power-of-two capacity)
+//         push()/emplace() add items at the back, front()/pop() take them from the front
+
+enum class QueueCapacity
+{
+    growable, // buffer is doubled when full
+    fixed     // push() throws std::length_error when full (try_push() returns false)
+};
+
+template <typename T>
+class Queue
+{
+    T* items_ {};
+    size_t capacity_ {}; // zero or power of two
+    size_t head_ {};     // index of front (not wrapped)
+    size_t tail_ {};     // index past back (not wrapped)
+    QueueCapacity capacity_policy_ {QueueCapacity::growable};
+
+    static size_t round_up_to_power_of_two(size_t n) noexcept
+    {
+        size_t result = 1;
+        while (result < n)
+            result *= 2;
+        return result;
+    }
+
+    static T* allocate(size_t capacity)
+    {
+        return capacity ? std::allocator<T> {}.allocate(capacity) : nullptr;
+    }
+
+    static void deallocate(T* items, size_t capacity) noexcept
+    {
+        if (items)
+            std::allocator<T> {}.deallocate(items, capacity);
+    }
+
+    size_t mask() const noexcept
+    {
+        return capacity_ - 1;
+    }
+
+    T* slot(size_t index) const noexcept
+    {
+        return items_ + (index & mask());
+    }
+
+    bool has_space_for(size_t count) const noexcept
+    {
+        return size() + count <= capacity_;
+    }
+
+    // moves items to new buffer (front is placed at index 0) after construct_back(T* back) has constructed count new items
+    // behind them - new items are built first, because arguments may refer to items of this queue
+    template <typename TConstructBack>
+    void grow(size_t count, TConstructBack construct_back)
+    {
+        const size_t new_capacity = round_up_to_power_of_two(std::max<size_t>(size() + count, 2 * capacity_));
+        T* new_items = allocate(new_capacity);
+        const size_t old_count = size();
+
+        try
+        {
+            construct_back(new_items + old_count); // constructs all or nothing
+        }
+        catch (...)
+        {
+            deallocate(new_items, new_capacity);
+            throw;
+        }
+
+        size_t moved = 0;
+        try
+        {
+            for (; moved < old_count; ++moved)
+                new (new_items + moved) T(std::move_if_noexcept(*slot(head_ + moved)));
+        }
+        catch (...)
+        {
+            std::destroy(new_items, new_items + moved);
+            std::destroy(new_items + old_count, new_items + old_count + count);
+            deallocate(new_items, new_capacity);
+            throw;
+        }
+
+        clear();
+        deallocate(items_, capacity_);
+
+        items_ = new_items;
+        capacity_ = new_capacity;
+        head_ = 0;
+        tail_ = old_count + count;
+    }
+
+public:
+    using value_type = T;
+
+    Queue() = default;
+
+    explicit Queue(size_t capacity, QueueCapacity capacity_policy = QueueCapacity::growable)
+        : items_ {allocate(round_up_to_power_of_two(capacity))}
+        , capacity_ {round_up_to_power_of_two(capacity)}
+        , capacity_policy_ {capacity_policy}
+    {
+    }
+
+    // delegating constructor - destructor releases buffer & copied items if copy of item throws
+    Queue(const Queue& other)
+        : Queue {}
+    {
+        items_ = allocate(other.capacity_);
+        capacity_ = other.capacity_;
+        capacity_policy_ = other.capacity_policy_;
+
+        for (size_t i = other.head_; i != other.tail_; ++i)
+        {
+            new (slot(tail_)) T(*other.slot(i));
+            ++tail_;
+        }
+    }
+
+    Queue& operator=(const Queue& other)
+    {
+        Queue temp(other);
+        swap(temp);
+
+        return *this;
+    }
+
+    Queue(Queue&& other) noexcept
+        : items_ {std::exchange(other.items_, nullptr)}
+        , capacity_ {std::exchange(other.capacity_, 0)}
+        , head_ {std::exchange(other.head_, 0)}
+        , tail_ {std::exchange(other.tail_, 0)}
+        , capacity_policy_ {other.capacity_policy_}
+    {
+    }
+
+    Queue& operator=(Queue&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Queue temp(std::move(other));
+            swap(temp);
+        }
+
+        return *this;
+    }
+
+    ~Queue()
+    {
+        clear();
+        deallocate(items_, capacity_);
+    }
+
+    void swap(Queue& other) noexcept
+    {
+        std::swap(items_, other.items_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(head_, other.head_);
+        std::swap(tail_, other.tail_);
+        std::swap(capacity_policy_, other.capacity_policy_);
+    }
+
+    size_t size() const noexcept
+    {
+        return tail_ - head_;
+    }
+
+    bool empty() const noexcept
+    {
+        return head_ == tail_;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    void push(const T& item)
+    {
+        emplace(item);
+    }
+
+    void push(T&& item)
+    {
+        emplace(std::move(item));
+    }
+
+    template <typename... TArgs>
+    T& emplace(TArgs&&... args)
+    {
+        if (!has_space_for(1))
+        {
+            if (capacity_policy_ == QueueCapacity::fixed)
+                throw std::length_error("Queue is full");
+
+            grow(1, [&](T* back) { new (back) T(std::forward<TArgs>(args)...); });
+            return this->back();
+        }
+
+        T* item = new (slot(tail_)) T(std::forward<TArgs>(args)...);
+        ++tail_;
+
+        return *item;
+    }
+
+    // returns false if fixed capacity queue is full
+    template <typename TItem>
+    bool try_push(TItem&& item)
+    {
+        if (!has_space_for(1))
+        {
+            if (capacity_policy_ == QueueCapacity::fixed)
+                return false;
+
+            grow(1, [&](T* back) { new (back) T(std::forward<TItem>(item)); });
+            return true;
+        }
+
+        new (slot(tail_)) T(std::forward<TItem>(item));
+        ++tail_;
+
+        return true;
+    }
+
+    void push_bulk(std::span<const T> items)
+    {
+        push_bulk(items.begin(), items.end());
+    }
+
+    // use std::make_move_iterator() to move items into queue
+    template <typename TIter>
+    void push_bulk(TIter first, TIter last)
+    {
+        const auto count = static_cast<size_t>(std::distance(first, last));
+
+        if (!has_space_for(count))
+        {
+            if (capacity_policy_ == QueueCapacity::fixed)
+                throw std::length_error("Queue is full");
+
+            grow(count, [&](T* back) { std::uninitialized_copy(first, last, back); });
+            return;
+        }
+
+        for (; first != last; ++first)
+        {
+            new (slot(tail_)) T(*first);
+            ++tail_;
+        }
+    }
+
+    T& front()
+    {
+        assert(!empty());
+        return *slot(head_);
+    }
+
+    const T& front() const
+    {
+        assert(!empty());
+        return *slot(head_);
+    }
+
+    T& back()
+    {
+        assert(!empty());
+        return *slot(tail_ - 1);
+    }
+
+    const T& back() const
+    {
+        assert(!empty());
+        return *slot(tail_ - 1);
+    }
+
+    void pop()
+    {
+        assert(!empty());
+        std::destroy_at(slot(head_));
+        ++head_;
+    }
+
+    // moves up to out.size() items from the front into out - returns number of popped items
+    size_t pop_bulk(std::span<T> out)
+    {
+        const size_t count = std::min(out.size(), size());
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            T* item = slot(head_);
+            out[i] = std::move(*item);
+            std::destroy_at(item);
+            ++head_;
+        }
+
+        return count;
+    }
+
+    void clear() noexcept
+    {
+        for (; head_ != tail_; ++head_)
+            std::destroy_at(slot(head_));
+
+        head_ = tail_ = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef ROW_VIEW_HPP
+#define ROW_VIEW_HPP
+
+#include <cstddef>
+#include <string_view>
+
+////////////////////////////////////////////////////////////////////////////
+// BasicRowView - non-owning view of named row of items (iterated like Data)
+
+template <typename T>
+class BasicRowView
+{
+    std::string_view name_;
+    T* first_;
+    T* last_;
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    BasicRowView(std::string_view name, T* first, T* last) noexcept
+        : name_ {name}
+        , first_ {first}
+        , last_ {last}
+    {
+    }
+
+    std::string_view name() const noexcept
+    {
+        return name_;
+    }
+
+    size_t size() const noexcept
+    {
+        return static_cast<size_t>(last_ - first_);
+    }
+
+    iterator begin() const noexcept
+    {
+        return first_;
+    }
+
+    iterator end() const noexcept
+    {
+        return last_;
+    }
+};
+
+#endif
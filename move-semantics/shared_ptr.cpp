@@ -0,0 +1,178 @@
+#include "catch.hpp"
+#include "alloc_stats.hpp"
+#include "gadget.hpp"
+#include "shared_ptr.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Document : RefCounted<Document>
+    {
+        std::string title;
+
+        explicit Document(std::string t)
+            : title {std::move(t)}
+        {
+        }
+
+        SharedPtr<Document> shared_from_this()
+        {
+            return SharedPtr<Document> {this};
+        }
+    };
+
+    struct LocalDocument : RefCounted<LocalDocument, NonAtomicRefCount>
+    {
+        int pages {};
+    };
+
+    struct Base
+    {
+        virtual ~Base() = default;
+    };
+
+    struct Derived : Base
+    {
+        int value {42};
+    };
+}
+
+static_assert(sizeof(SharedPtr<Document>) == sizeof(Document*));
+static_assert(sizeof(SharedPtr<Gadget>) == 2 * sizeof(Gadget*));
+
+TEST_CASE("SharedPtr - intrusive counter")
+{
+    SharedPtr<Document> doc = MakeShared<Document>("draft");
+    REQUIRE(doc.use_count() == 1);
+
+    SharedPtr<Document> other = doc->shared_from_this();
+    REQUIRE(other.get() == doc.get());
+    REQUIRE(doc.use_count() == 2);
+
+    doc.reset();
+    REQUIRE(other.use_count() == 1);
+    REQUIRE((*other).title == "draft");
+
+    SharedPtr<LocalDocument> local_doc = MakeShared<LocalDocument>();
+    SharedPtr<LocalDocument> local_copy = local_doc;
+    REQUIRE(local_copy.use_count() == 2);
+}
+
+TEST_CASE("SharedPtr - MakeShared with single allocation")
+{
+    AllocStats::Scope alloc_scope;
+    SharedPtr<std::vector<int>> vec = MakeShared<std::vector<int>>();
+    const size_t allocations = alloc_scope.allocations();
+
+    REQUIRE(allocations == 1);
+
+    SECTION("copy & move")
+    {
+        SharedPtr<std::vector<int>> copy = vec;
+        REQUIRE(vec.use_count() == 2);
+
+        SharedPtr<std::vector<int>> target = std::move(copy);
+        REQUIRE_FALSE(copy);
+        REQUIRE(target.use_count() == 2);
+
+        target->push_back(1);
+        REQUIRE(vec->size() == 1);
+    }
+
+    SECTION("assignments")
+    {
+        SharedPtr<std::vector<int>> other = MakeShared<std::vector<int>>(3, 1);
+        other = vec;
+        REQUIRE(vec.use_count() == 2);
+
+        other = nullptr;
+        REQUIRE(vec.use_count() == 1);
+    }
+
+    SECTION("single-threaded counting")
+    {
+        SharedPtr<std::string, NonAtomicRefCount> text = MakeShared<std::string, NonAtomicRefCount>("text");
+        auto copy = text;
+        REQUIRE(copy.use_count() == 2);
+    }
+}
+
+TEST_CASE("SharedPtr - conversion from derived")
+{
+    SharedPtr<Derived> derived = MakeShared<Derived>();
+    SharedPtr<Base> base = derived;
+
+    REQUIRE(base.get() == derived.get());
+    REQUIRE(derived.use_count() == 2);
+
+    derived.reset();
+    REQUIRE(base.use_count() == 1);
+}
+
+namespace
+{
+    struct Counted : RefCounted<Counted>
+    {
+        int value {1};
+    };
+
+    struct LocalCounted : RefCounted<LocalCounted, NonAtomicRefCount>
+    {
+        int value {1};
+    };
+
+    // copies every pointer of source & destroys copies
+    template <typename TPtr>
+    long copy_destroy(const std::vector<TPtr>& source, std::vector<TPtr>& copies)
+    {
+        copies.assign(source.begin(), source.end());
+        long sum = copies.back().use_count();
+        copies.clear();
+        return sum;
+    }
+}
+
+TEST_CASE("SharedPtr vs. std::shared_ptr - copy & destroy", "[.][benchmark]")
+{
+    const int count = 10'000;
+
+    std::vector<std::shared_ptr<int>> std_ptrs(count, std::make_shared<int>(1));
+    std::vector<SharedPtr<int>> atomic_ptrs(count, MakeShared<int>(1));
+    std::vector<SharedPtr<int, NonAtomicRefCount>> local_ptrs(count, MakeShared<int, NonAtomicRefCount>(1));
+    std::vector<SharedPtr<Counted>> intrusive_ptrs(count, MakeShared<Counted>());
+    std::vector<SharedPtr<LocalCounted>> local_intrusive_ptrs(count, MakeShared<LocalCounted>());
+
+    std::vector<std::shared_ptr<int>> std_copies;
+    std::vector<SharedPtr<int>> atomic_copies;
+    std::vector<SharedPtr<int, NonAtomicRefCount>> local_copies;
+    std::vector<SharedPtr<Counted>> intrusive_copies;
+    std::vector<SharedPtr<LocalCounted>> local_intrusive_copies;
+
+    // note: libstdc++ uses non-atomic counting while process has never started other thread
+    BENCHMARK("std::shared_ptr")
+    {
+        return copy_destroy(std_ptrs, std_copies);
+    };
+
+    BENCHMARK("SharedPtr<T, AtomicRefCount> - MakeShared")
+    {
+        return copy_destroy(atomic_ptrs, atomic_copies);
+    };
+
+    BENCHMARK("SharedPtr<T, NonAtomicRefCount> - MakeShared")
+    {
+        return copy_destroy(local_ptrs, local_copies);
+    };
+
+    BENCHMARK("SharedPtr<T> - intrusive, AtomicRefCount")
+    {
+        return copy_destroy(intrusive_ptrs, intrusive_copies);
+    };
+
+    BENCHMARK("SharedPtr<T> - intrusive, NonAtomicRefCount")
+    {
+        return copy_destroy(local_intrusive_ptrs, local_intrusive_copies);
+    };
+}
@@ -0,0 +1,410 @@
+#ifndef SHARED_PTR_HPP
+#define SHARED_PTR_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////
+// Reference counting policies
+//   AtomicRefCount    - SharedPtr copies may be shared between threads
+//   NonAtomicRefCount - single-threaded use only (no lock-prefixed instructions)
+
+struct AtomicRefCount
+{
+    using counter_type = std::atomic<long>;
+
+    static void increment(counter_type& counter) noexcept
+    {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // returns true if last reference was released
+    static bool decrement(counter_type& counter) noexcept
+    {
+        return counter.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    static long load(const counter_type& counter) noexcept
+    {
+        return counter.load(std::memory_order_relaxed);
+    }
+};
+
+struct NonAtomicRefCount
+{
+    using counter_type = long;
+
+    static void increment(counter_type& counter) noexcept
+    {
+        ++counter;
+    }
+
+    static bool decrement(counter_type& counter) noexcept
+    {
+        return --counter == 0;
+    }
+
+    static long load(const counter_type& counter) noexcept
+    {
+        return counter;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// RefCounted - base class of intrusively counted types (counter lives inside object)
+//              SharedPtr<TDerived> is then pointer-sized & may be created from raw this
+
+template <typename TDerived, typename TPolicy = AtomicRefCount>
+class RefCounted
+{
+    mutable typename TPolicy::counter_type ref_count_ {0};
+
+public:
+    using ref_count_policy = TPolicy;
+
+    void add_ref() const noexcept
+    {
+        TPolicy::increment(ref_count_);
+    }
+
+    void release() const noexcept
+    {
+        if (TPolicy::decrement(ref_count_))
+            delete static_cast<const TDerived*>(this);
+    }
+
+    long use_count() const noexcept
+    {
+        return TPolicy::load(ref_count_);
+    }
+
+protected:
+    RefCounted() = default;
+
+    // copy of object starts with its own count
+    RefCounted(const RefCounted&) noexcept
+    {
+    }
+
+    RefCounted& operator=(const RefCounted&) noexcept
+    {
+        return *this;
+    }
+
+    ~RefCounted() = default;
+};
+
+namespace Detail
+{
+    template <typename T, typename = void>
+    struct IsIntrusive : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct IsIntrusive<T, std::void_t<typename T::ref_count_policy>> : std::true_type
+    {
+    };
+
+    template <typename T, typename = void>
+    struct RefCountPolicyOf
+    {
+        using type = AtomicRefCount;
+    };
+
+    template <typename T>
+    struct RefCountPolicyOf<T, std::void_t<typename T::ref_count_policy>>
+    {
+        using type = typename T::ref_count_policy;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // SharedBlockBase - counter of non-intrusive object created by MakeShared
+
+    template <typename TPolicy>
+    class SharedBlockBase
+    {
+        typename TPolicy::counter_type ref_count_ {1};
+
+    protected:
+        virtual ~SharedBlockBase() = default;
+
+    public:
+        void add_ref() noexcept
+        {
+            TPolicy::increment(ref_count_);
+        }
+
+        void release() noexcept
+        {
+            if (TPolicy::decrement(ref_count_))
+                delete this;
+        }
+
+        long use_count() const noexcept
+        {
+            return TPolicy::load(ref_count_);
+        }
+    };
+
+    // counter & object in single allocation
+    template <typename T, typename TPolicy>
+    class SharedBlock final : public SharedBlockBase<TPolicy>
+    {
+        T value_;
+
+    public:
+        template <typename... TArgs>
+        explicit SharedBlock(TArgs&&... args)
+            : value_(std::forward<TArgs>(args)...)
+        {
+        }
+
+        T* get() noexcept
+        {
+            return &value_;
+        }
+    };
+
+    template <typename T, typename TPolicy, bool Intrusive = IsIntrusive<T>::value>
+    struct SharedPtrStorage
+    {
+        T* ptr_ {};
+
+        void add_ref() const noexcept
+        {
+            if (ptr_)
+                ptr_->add_ref();
+        }
+
+        void release() noexcept
+        {
+            if (ptr_)
+                ptr_->release();
+        }
+
+        long count() const noexcept
+        {
+            return ptr_ ? ptr_->use_count() : 0;
+        }
+
+        void swap_storage(SharedPtrStorage& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+        }
+
+        template <typename U>
+        void steal(SharedPtrStorage<U, TPolicy>& other) noexcept
+        {
+            ptr_ = std::exchange(other.ptr_, nullptr);
+        }
+
+        template <typename U>
+        void share(const SharedPtrStorage<U, TPolicy>& other) noexcept
+        {
+            ptr_ = other.ptr_;
+            add_ref();
+        }
+    };
+
+    template <typename T, typename TPolicy>
+    struct SharedPtrStorage<T, TPolicy, false>
+    {
+        T* ptr_ {};
+        SharedBlockBase<TPolicy>* block_ {};
+
+        void add_ref() const noexcept
+        {
+            if (block_)
+                block_->add_ref();
+        }
+
+        void release() noexcept
+        {
+            if (block_)
+                block_->release();
+        }
+
+        long count() const noexcept
+        {
+            return block_ ? block_->use_count() : 0;
+        }
+
+        void swap_storage(SharedPtrStorage& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+            std::swap(block_, other.block_);
+        }
+
+        template <typename U>
+        void steal(SharedPtrStorage<U, TPolicy>& other) noexcept
+        {
+            ptr_ = std::exchange(other.ptr_, nullptr);
+            block_ = std::exchange(other.block_, nullptr);
+        }
+
+        template <typename U>
+        void share(const SharedPtrStorage<U, TPolicy>& other) noexcept
+        {
+            ptr_ = other.ptr_;
+            block_ = other.block_;
+            add_ref();
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////
+// SharedPtr - shared ownership of object
+//             intrusive types (derived from RefCounted) keep counter inside object,
+//             other types must be created with MakeShared (counter + object in one allocation)
+
+template <typename T, typename TPolicy = typename Detail::RefCountPolicyOf<T>::type>
+class SharedPtr : private Detail::SharedPtrStorage<T, TPolicy>
+{
+    using Storage = Detail::SharedPtrStorage<T, TPolicy>;
+
+    template <typename U, typename P>
+    friend class SharedPtr;
+
+    template <typename U, typename P, typename... TArgs>
+    friend SharedPtr<U, P> MakeShared(TArgs&&... args);
+
+    static_assert(!Detail::IsIntrusive<T>::value || std::is_same_v<TPolicy, typename Detail::RefCountPolicyOf<T>::type>,
+        "policy of SharedPtr must match policy of RefCounted base");
+
+    template <typename U>
+    static constexpr bool is_compatible_v = std::is_convertible_v<U*, T*>;
+
+    Storage& storage() noexcept
+    {
+        return *this;
+    }
+
+    const Storage& storage() const noexcept
+    {
+        return *this;
+    }
+
+public:
+    using element_type = T;
+
+    SharedPtr() noexcept = default;
+
+    SharedPtr(std::nullptr_t) noexcept
+    {
+    }
+
+    // takes shared ownership of intrusively counted object
+    template <typename U = T, typename = std::enable_if_t<Detail::IsIntrusive<U>::value>>
+    explicit SharedPtr(T* ptr) noexcept
+    {
+        this->ptr_ = ptr;
+        this->add_ref();
+    }
+
+    SharedPtr(const SharedPtr& other) noexcept
+    {
+        this->share(other.storage());
+    }
+
+    template <typename U, typename = std::enable_if_t<is_compatible_v<U>>>
+    SharedPtr(const SharedPtr<U, TPolicy>& other) noexcept
+    {
+        this->share(other.storage());
+    }
+
+    SharedPtr(SharedPtr&& other) noexcept
+    {
+        this->steal(other.storage());
+    }
+
+    template <typename U, typename = std::enable_if_t<is_compatible_v<U>>>
+    SharedPtr(SharedPtr<U, TPolicy>&& other) noexcept
+    {
+        this->steal(other.storage());
+    }
+
+    SharedPtr& operator=(const SharedPtr& other) noexcept
+    {
+        SharedPtr temp(other);
+        swap(temp);
+
+        return *this;
+    }
+
+    SharedPtr& operator=(SharedPtr&& other) noexcept
+    {
+        SharedPtr temp(std::move(other));
+        swap(temp);
+
+        return *this;
+    }
+
+    ~SharedPtr() noexcept
+    {
+        this->release();
+    }
+
+    void swap(SharedPtr& other) noexcept
+    {
+        this->swap_storage(other);
+    }
+
+    void reset() noexcept
+    {
+        SharedPtr {}.swap(*this);
+    }
+
+    long use_count() const noexcept
+    {
+        return this->count();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return this->ptr_ != nullptr;
+    }
+
+    T* get() const noexcept
+    {
+        return this->ptr_;
+    }
+
+    T* operator->() const noexcept
+    {
+        return this->ptr_;
+    }
+
+    T& operator*() const noexcept
+    {
+        assert(this->ptr_ != nullptr);
+        return *this->ptr_;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// MakeShared<T>(args...) - intrusive type: new T, otherwise counter & T in one allocation
+
+template <typename T, typename TPolicy = typename Detail::RefCountPolicyOf<T>::type, typename... TArgs>
+SharedPtr<T, TPolicy> MakeShared(TArgs&&... args)
+{
+    if constexpr (Detail::IsIntrusive<T>::value)
+    {
+        return SharedPtr<T, TPolicy>(new T(std::forward<TArgs>(args)...));
+    }
+    else
+    {
+        auto* block = new Detail::SharedBlock<T, TPolicy>(std::forward<TArgs>(args)...);
+
+        SharedPtr<T, TPolicy> result;
+        result.storage().ptr_ = block->get();
+        result.storage().block_ = block;
+
+        return result;
+    }
+}
+
+#endif
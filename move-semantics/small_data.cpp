@@ -0,0 +1,154 @@
+#include "catch.hpp"
+#include "alloc_stats.hpp"
+#include "data.hpp"
+#include "small_data.hpp"
+#include <vector>
+
+using Row = SmallData<12>;
+
+Row create_small_data_set()
+{
+    Row ds {"data-set-one", {54, 6, 34, 235, 64356, 235, 23}};
+
+    return ds;
+}
+
+TEST_CASE("SmallData - inline storage")
+{
+    AllocStats::Scope alloc_scope;
+
+    Row ds1 = create_small_data_set();
+
+    REQUIRE(alloc_scope.allocations() == 0);
+    REQUIRE(ds1.is_inline());
+    REQUIRE(std::vector<int>(ds1.begin(), ds1.end()) == std::vector<int> {54, 6, 34, 235, 64356, 235, 23});
+
+    SECTION("copy")
+    {
+        AllocStats::Scope copy_scope;
+        Row backup = ds1;
+
+        REQUIRE(copy_scope.allocations() == 0);
+        REQUIRE(backup.is_inline());
+        REQUIRE(std::equal(backup.begin(), backup.end(), ds1.begin(), ds1.end()));
+    }
+
+    SECTION("move")
+    {
+        AllocStats::Scope move_scope;
+        Row target = std::move(ds1);
+
+        REQUIRE(move_scope.allocations() == 0);
+        REQUIRE(target.is_inline());
+        REQUIRE(target.size() == 7);
+        REQUIRE(ds1.size() == 0);
+    }
+}
+
+TEST_CASE("SmallData - heap storage above inline capacity")
+{
+    SmallData<4> ds1 {"ds1", {1, 2, 3, 4, 5, 6}};
+
+    REQUIRE_FALSE(ds1.is_inline());
+
+    SECTION("copy allocates new buffer")
+    {
+        SmallData<4> backup = ds1;
+
+        REQUIRE_FALSE(backup.is_inline());
+        REQUIRE(backup.begin() != ds1.begin());
+        REQUIRE(std::equal(backup.begin(), backup.end(), ds1.begin(), ds1.end()));
+    }
+
+    SECTION("move steals buffer")
+    {
+        const int* buffer = ds1.begin();
+
+        AllocStats::Scope alloc_scope;
+        SmallData<4> target = std::move(ds1);
+
+        REQUIRE(target.begin() == buffer);
+        REQUIRE(ds1.size() == 0);
+        REQUIRE(ds1.is_inline());
+        REQUIRE(alloc_scope.allocations() == 0);
+    }
+}
+
+TEST_CASE("SmallData - swap & assignment between modes")
+{
+    SmallData<4> small {"small", {1, 2}};
+    SmallData<4> large {"large", {1, 2, 3, 4, 5, 6}};
+    const int* large_buffer = large.begin();
+
+    SECTION("swap")
+    {
+        small.swap(large);
+
+        REQUIRE(small.name() == "large");
+        REQUIRE(small.begin() == large_buffer);
+        REQUIRE(large.is_inline());
+        REQUIRE(std::vector<int>(large.begin(), large.end()) == std::vector<int> {1, 2});
+
+        SmallData<4> other {"other", {7, 8, 9}};
+        large.swap(other);
+        REQUIRE(std::vector<int>(large.begin(), large.end()) == std::vector<int> {7, 8, 9});
+        REQUIRE(std::vector<int>(other.begin(), other.end()) == std::vector<int> {1, 2});
+    }
+
+    SECTION("copy assignment")
+    {
+        large = small;
+        REQUIRE(large.is_inline());
+        REQUIRE(std::vector<int>(large.begin(), large.end()) == std::vector<int> {1, 2});
+    }
+
+    SECTION("move assignment")
+    {
+        small = std::move(large);
+        REQUIRE(small.begin() == large_buffer);
+        REQUIRE(large.size() == 0);
+    }
+}
+
+TEST_CASE("SmallData - vector of rows", "[.][benchmark]")
+{
+    const int rows_count = 100'000;
+
+    auto count_allocations = [](auto make_row) {
+        AllocStats::Scope alloc_scope;
+        {
+            std::vector<decltype(make_row())> rows;
+            rows.reserve(rows_count);
+            for (int i = 0; i < rows_count; ++i)
+                rows.push_back(make_row());
+        }
+        return alloc_scope.allocations();
+    };
+
+    auto data_row = [] { return Data {"ds-large", {1, 2, 53, 45, 645, 75647, 7561, 2, 3, 4, 5}}; };
+    auto inline_row = [] { return Row {"ds-large", {1, 2, 53, 45, 645, 75647, 7561, 2, 3, 4, 5}}; };
+    auto heap_row = [] { return SmallData<4> {"ds-large", {1, 2, 53, 45, 645, 75647, 7561, 2, 3, 4, 5}}; };
+
+    std::cout.setstate(std::ios::failbit); // silence Data traces
+    const auto data_allocations = count_allocations(data_row);
+    std::cout.clear();
+    const auto inline_allocations = count_allocations(inline_row);
+    const auto heap_allocations = count_allocations(heap_row);
+
+    std::cout << "allocations for " << rows_count << " rows - Data: " << data_allocations
+              << ", SmallData (inline): " << inline_allocations
+              << ", SmallData (heap): " << heap_allocations << "\n";
+
+    REQUIRE(inline_allocations < heap_allocations);
+    REQUIRE(heap_allocations == data_allocations);
+
+    BENCHMARK("SmallData - inline mode")
+    {
+        return inline_row();
+    };
+
+    BENCHMARK("SmallData - heap mode")
+    {
+        return heap_row();
+    };
+}
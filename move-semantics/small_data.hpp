@@ -0,0 +1,157 @@
+#ifndef SMALL_DATA_HPP
+#define SMALL_DATA_HPP
+
+#include <algorithm>
+#include <initializer_list>
+#include <string>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////
+// SmallData - Data with inline storage for up to InlineN items
+//             (larger payloads are allocated on the heap)
+
+template <size_t InlineN>
+class SmallData
+{
+    static_assert(InlineN > 0, "inline capacity must be greater than zero");
+
+    std::string name_;
+    int* data_;
+    size_t size_;
+    int buffer_[InlineN];
+
+    int* allocate(size_t size)
+    {
+        return size <= InlineN ? buffer_ : new int[size];
+    }
+
+public:
+    using iterator = int*;
+    using const_iterator = const int*;
+
+    static constexpr size_t inline_capacity = InlineN;
+
+    SmallData(std::string name, std::initializer_list<int> list)
+        : name_ {std::move(name)}
+        , data_ {allocate(list.size())}
+        , size_ {list.size()}
+    {
+        std::copy(list.begin(), list.end(), data_);
+    }
+
+    SmallData(const SmallData& other)
+        : name_(other.name_)
+        , data_ {allocate(other.size_)}
+        , size_(other.size_)
+    {
+        std::copy(other.begin(), other.end(), data_);
+    }
+
+    SmallData& operator=(const SmallData& other)
+    {
+        SmallData temp(other);
+        swap(temp);
+
+        return *this;
+    }
+
+    // inline items are copied - heap buffer is stolen
+    SmallData(SmallData&& other) noexcept
+        : name_ {std::move(other.name_)}
+        , data_ {buffer_}
+        , size_ {other.size_}
+    {
+        if (other.is_inline())
+            std::copy(other.begin(), other.end(), buffer_);
+        else
+            data_ = other.data_;
+
+        other.data_ = other.buffer_;
+        other.size_ = 0;
+    }
+
+    SmallData& operator=(SmallData&& other) noexcept
+    {
+        if (this != &other)
+        {
+            SmallData temp(std::move(other));
+            swap(temp);
+        }
+
+        return *this;
+    }
+
+    ~SmallData() noexcept
+    {
+        if (!is_inline())
+            delete[] data_;
+    }
+
+    void swap(SmallData& other) noexcept
+    {
+        name_.swap(other.name_);
+
+        if (is_inline() && other.is_inline())
+        {
+            int temp[InlineN];
+            std::copy(begin(), end(), temp);
+            std::copy(other.begin(), other.end(), buffer_);
+            std::copy(temp, temp + size_, other.buffer_);
+        }
+        else if (is_inline())
+        {
+            std::copy(begin(), end(), other.buffer_);
+            data_ = other.data_;
+            other.data_ = other.buffer_;
+        }
+        else if (other.is_inline())
+        {
+            std::copy(other.begin(), other.end(), buffer_);
+            other.data_ = data_;
+            data_ = buffer_;
+        }
+        else
+        {
+            std::swap(data_, other.data_);
+        }
+
+        std::swap(size_, other.size_);
+    }
+
+    bool is_inline() const noexcept
+    {
+        return data_ == buffer_;
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    const std::string& name() const noexcept
+    {
+        return name_;
+    }
+
+    iterator begin() noexcept
+    {
+        return data_;
+    }
+
+    iterator end() noexcept
+    {
+        return data_ + size_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return data_;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return data_ + size_;
+    }
+};
+
+#endif
@@ -0,0 +1,145 @@
+#include "catch.hpp"
+#include "queue.hpp"
+#include "spsc_queue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("SpscQueue - single thread")
+{
+    SpscQueue<std::string> q {3};
+    REQUIRE(q.capacity() == 4);
+    REQUIRE(q.try_front() == nullptr);
+
+    q.push("one");
+    q.emplace(3, 'c');
+    REQUIRE(q.try_push("three"));
+    REQUIRE(q.try_emplace("four"));
+    REQUIRE_FALSE(q.try_push("five"));
+    REQUIRE(q.size() == 4);
+
+    REQUIRE(*q.try_front() == "one");
+    REQUIRE(q.front() == "one");
+    q.pop();
+
+    std::string item;
+    REQUIRE(q.try_pop(item));
+    REQUIRE(item == "ccc");
+
+    REQUIRE(q.try_push("five")); // wraps around
+}
+
+TEST_CASE("SpscQueue - producer & consumer threads")
+{
+    const int count = 100'000;
+    SpscQueue<std::unique_ptr<int>> q {64};
+
+    std::thread producer {[&q] {
+        for (int i = 0; i < count; ++i)
+            q.push(std::make_unique<int>(i));
+    }};
+
+    std::vector<int> received;
+    received.reserve(count);
+
+    std::unique_ptr<int> item;
+    while (received.size() < count)
+    {
+        if (q.try_pop(item))
+            received.push_back(*item);
+        else
+            std::this_thread::yield();
+    }
+
+    producer.join();
+
+    REQUIRE(q.empty());
+    REQUIRE(std::is_sorted(received.begin(), received.end()));
+    REQUIRE(received.back() == count - 1);
+}
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct HandoffStats
+    {
+        double ops_per_second;
+        Clock::duration p99_latency;
+    };
+
+    // producer pushes timestamps - consumer measures time of handoff
+    template <typename TPush, typename TTryPop>
+    HandoffStats measure_handoff(int count, TPush push, TTryPop try_pop)
+    {
+        std::vector<Clock::duration> latencies;
+        latencies.reserve(count);
+
+        const auto start = Clock::now();
+
+        std::thread producer {[&] {
+            for (int i = 0; i < count; ++i)
+                push(Clock::now());
+        }};
+
+        Clock::time_point timestamp;
+        while (latencies.size() < static_cast<size_t>(count))
+        {
+            if (try_pop(timestamp))
+                latencies.push_back(Clock::now() - timestamp);
+            else
+                std::this_thread::yield();
+        }
+
+        producer.join();
+
+        const auto elapsed = std::chrono::duration<double>(Clock::now() - start);
+
+        auto p99 = latencies.begin() + latencies.size() * 99 / 100;
+        std::nth_element(latencies.begin(), p99, latencies.end());
+
+        return HandoffStats {count / elapsed.count(), *p99};
+    }
+
+    void print(const std::string& name, const HandoffStats& stats)
+    {
+        std::cout << name << " - " << static_cast<long long>(stats.ops_per_second) << " ops/s, p99 handoff: "
+                  << std::chrono::duration_cast<std::chrono::nanoseconds>(stats.p99_latency).count() << " ns\n";
+    }
+}
+
+TEST_CASE("SpscQueue - two threads handoff", "[.][benchmark]")
+{
+    const int count = 1'000'000;
+
+    std::mutex mtx;
+    Queue<Clock::time_point> locked_queue {1024};
+    const auto locked_stats = measure_handoff(
+        count,
+        [&](Clock::time_point ts) {
+            std::lock_guard lk {mtx};
+            locked_queue.push(ts);
+        },
+        [&](Clock::time_point& ts) {
+            std::lock_guard lk {mtx};
+            if (locked_queue.empty())
+                return false;
+            ts = locked_queue.front();
+            locked_queue.pop();
+            return true;
+        });
+
+    SpscQueue<Clock::time_point> spsc_queue {1024};
+    const auto spsc_stats = measure_handoff(
+        count,
+        [&](Clock::time_point ts) { spsc_queue.push(ts); },
+        [&](Clock::time_point& ts) { return spsc_queue.try_pop(ts); });
+
+    print("std::mutex + Queue", locked_stats);
+    print("SpscQueue", spsc_stats);
+}
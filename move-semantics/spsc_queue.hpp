@@ -0,0 +1,181 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////
+// SpscQueue - wait-free single-producer/single-consumer queue (fixed capacity ring buffer)
+//             push()/emplace() may be called only by producer thread,
+//             front()/pop()/try_front()/try_pop() only by consumer thread
+
+template <typename T>
+class SpscQueue
+{
+    static constexpr size_t cache_line_size = 64;
+
+    // producer side - consumer only reads tail
+    struct alignas(cache_line_size) ProducerIndex
+    {
+        std::atomic<size_t> tail {};
+        size_t cached_head {}; // last head seen by producer
+    };
+
+    // consumer side - producer only reads head
+    struct alignas(cache_line_size) ConsumerIndex
+    {
+        std::atomic<size_t> head {};
+        size_t cached_tail {}; // last tail seen by consumer
+    };
+
+    ProducerIndex producer_;
+    ConsumerIndex consumer_;
+    size_t capacity_;
+    T* items_;
+
+    static size_t round_up_to_power_of_two(size_t n) noexcept
+    {
+        size_t result = 1;
+        while (result < n)
+            result *= 2;
+        return result;
+    }
+
+    T* slot(size_t index) const noexcept
+    {
+        return items_ + (index & (capacity_ - 1));
+    }
+
+public:
+    using value_type = T;
+
+    explicit SpscQueue(size_t capacity)
+        : capacity_ {round_up_to_power_of_two(capacity)}
+        , items_ {std::allocator<T> {}.allocate(capacity_)}
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue()
+    {
+        while (try_front())
+            pop();
+
+        std::allocator<T> {}.deallocate(items_, capacity_);
+    }
+
+    size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    // returns false if queue is full
+    template <typename... TArgs>
+    bool try_emplace(TArgs&&... args)
+    {
+        const size_t tail = producer_.tail.load(std::memory_order_relaxed);
+
+        if (tail - producer_.cached_head == capacity_)
+        {
+            producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+            if (tail - producer_.cached_head == capacity_)
+                return false;
+        }
+
+        new (slot(tail)) T(std::forward<TArgs>(args)...);
+        producer_.tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    template <typename TItem>
+    bool try_push(TItem&& item)
+    {
+        return try_emplace(std::forward<TItem>(item));
+    }
+
+    // spins (yielding) while queue is full
+    template <typename... TArgs>
+    void emplace(TArgs&&... args)
+    {
+        while (!try_emplace(std::forward<TArgs>(args)...))
+            std::this_thread::yield();
+    }
+
+    void push(const T& item)
+    {
+        emplace(item);
+    }
+
+    void push(T&& item)
+    {
+        emplace(std::move(item));
+    }
+
+    // never blocks - returns nullptr if queue is empty
+    T* try_front() noexcept
+    {
+        const size_t head = consumer_.head.load(std::memory_order_relaxed);
+
+        if (head == consumer_.cached_tail)
+        {
+            consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+            if (head == consumer_.cached_tail)
+                return nullptr;
+        }
+
+        return slot(head);
+    }
+
+    // as Queue<T>::front() - requires non-empty queue (e.g. after try_front() != nullptr)
+    T& front() noexcept
+    {
+        T* item = try_front();
+        assert(item);
+        return *item;
+    }
+
+    // requires non-empty queue
+    void pop() noexcept
+    {
+        const size_t head = consumer_.head.load(std::memory_order_relaxed);
+        assert(head != producer_.tail.load(std::memory_order_acquire));
+
+        std::destroy_at(slot(head));
+        consumer_.head.store(head + 1, std::memory_order_release);
+    }
+
+    // never blocks - returns false if queue is empty
+    bool try_pop(T& item)
+    {
+        T* item_ptr = try_front();
+        if (!item_ptr)
+            return false;
+
+        item = std::move(*item_ptr);
+        pop();
+
+        return true;
+    }
+
+    // approximate when called concurrently with push/pop
+    size_t size() const noexcept
+    {
+        const size_t head = consumer_.head.load(std::memory_order_acquire);
+        return producer_.tail.load(std::memory_order_acquire) - head;
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include "catch.hpp"
+#include "alloc_stats.hpp"
+#include "gadget.hpp"
+#include "string_interner.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("StringInterner - equal strings share one entry")
+{
+    StringInterner interner;
+
+    InternedString ipad = interner.intern("ipad");
+    InternedString other_ipad = interner.intern(std::string {"ip"} + "ad");
+    InternedString ipod = interner.intern("ipod");
+
+    REQUIRE(ipad == other_ipad);
+    REQUIRE(ipad.c_str() == other_ipad.c_str());
+    REQUIRE_FALSE(ipad == ipod);
+    REQUIRE(ipad == "ipad");
+    REQUIRE(interner.size() == 2);
+
+    SECTION("empty string")
+    {
+        REQUIRE(interner.intern("") == InternedString {});
+        REQUIRE(InternedString {}.view().empty());
+    }
+
+    SECTION("long strings")
+    {
+        const std::string long_text(100'000, 'x');
+        REQUIRE(interner.intern(long_text).view() == long_text);
+    }
+}
+
+TEST_CASE("StringInterner - concurrent interning")
+{
+    StringInterner interner;
+    const int threads_count = 4;
+    const int names_count = 1000;
+
+    std::vector<std::vector<InternedString>> results(threads_count);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threads_count; ++t)
+        threads.emplace_back([&interner, &names = results[t]] {
+            for (int i = 0; i < names_count; ++i)
+                names.push_back(interner.intern("Gadget-" + std::to_string(i)));
+        });
+
+    for (auto& thd : threads)
+        thd.join();
+
+    REQUIRE(interner.size() == names_count);
+    for (int t = 1; t < threads_count; ++t)
+        REQUIRE(results[t] == results[0]);
+}
+
+TEST_CASE("InternedGadget - name is interned handle")
+{
+    InternedGadget g1 {1, "ipad"};
+    InternedGadget g2 {2, std::string {"ipad"}};
+    InternedGadget g3;
+
+    REQUIRE(g1.name == g2.name);
+    REQUIRE(g3.name == "not-set");
+    REQUIRE(sizeof(InternedGadget) < sizeof(Gadget));
+}
+
+namespace
+{
+    // heavily repeating names - too long for small string optimization
+    std::string gadget_name(int id)
+    {
+        return "Gadget-Series-" + std::to_string(id % 10'000);
+    }
+
+    template <typename TGadget>
+    void measure_gadgets(const std::string& description, int gadgets_count)
+    {
+        std::vector<TGadget> gadgets;
+
+        std::cout.setstate(std::ios::failbit); // silence Gadget traces
+        AllocStats::Scope alloc_scope;
+        const auto start = std::chrono::steady_clock::now();
+
+        gadgets.reserve(gadgets_count);
+        std::string name_buffer; // reused - only memory held by gadgets is counted
+        for (int id = 0; id < gadgets_count; ++id)
+        {
+            name_buffer.assign("Gadget-Series-").append(std::to_string(id % 10'000));
+            gadgets.emplace_back(id, name_buffer);
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        const size_t bytes = alloc_scope.bytes();
+        std::cout.clear();
+
+        std::cout << description << " - " << static_cast<long long>(gadgets_count / elapsed.count()) << " gadgets/s, "
+                  << bytes / (1024 * 1024) << " MiB (" << bytes / gadgets_count << " bytes/gadget)\n";
+
+        std::cout.setstate(std::ios::failbit);
+        gadgets.clear();
+        std::cout.clear();
+    }
+}
+
+TEST_CASE("InternedGadget vs. Gadget - 10M gadgets", "[.][benchmark]")
+{
+    const int gadgets_count = 10'000'000;
+
+    measure_gadgets<Gadget>("Gadget - std::string name", gadgets_count);
+    measure_gadgets<InternedGadget>("InternedGadget - InternedString name", gadgets_count);
+}
+
+TEST_CASE("InternedString vs. std::string - equality", "[.][benchmark]")
+{
+    const int names_count = 1'000'000;
+
+    std::vector<std::string> names;
+    std::vector<InternedString> interned_names;
+    for (int i = 0; i < names_count; ++i)
+    {
+        names.push_back(gadget_name(i));
+        interned_names.push_back(gadget_name(i));
+    }
+
+    const std::string wanted = gadget_name(42);
+    const InternedString interned_wanted = wanted;
+
+    BENCHMARK("std::string ==")
+    {
+        return std::count(names.begin(), names.end(), wanted);
+    };
+
+    BENCHMARK("InternedString ==")
+    {
+        return std::count(interned_names.begin(), interned_names.end(), interned_wanted);
+    };
+}
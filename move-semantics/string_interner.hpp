@@ -0,0 +1,225 @@
+#ifndef STRING_INTERNER_HPP
+#define STRING_INTERNER_HPP
+
+#include "unique_ptr.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class StringInterner;
+
+////////////////////////////////////////////////////////////////////////////
+// InternedString - handle of string stored once in StringInterner
+//                  handles of equal strings point to the same entry (== compares pointers)
+
+class InternedString
+{
+    static inline const std::string_view empty_entry_ {""};
+
+    const std::string_view* entry_ {&empty_entry_};
+
+    friend class StringInterner;
+
+    explicit InternedString(const std::string_view* entry) noexcept
+        : entry_ {entry}
+    {
+    }
+
+public:
+    InternedString() = default;
+
+    // interns text in StringInterner::global()
+    InternedString(std::string_view text);
+
+    InternedString(const char* text)
+        : InternedString {std::string_view {text}}
+    {
+    }
+
+    InternedString(const std::string& text)
+        : InternedString {std::string_view {text}}
+    {
+    }
+
+    std::string_view view() const noexcept
+    {
+        return *entry_;
+    }
+
+    // interned chars are null-terminated
+    const char* c_str() const noexcept
+    {
+        return entry_->data();
+    }
+
+    size_t size() const noexcept
+    {
+        return entry_->size();
+    }
+
+    bool empty() const noexcept
+    {
+        return entry_->empty();
+    }
+
+    bool operator==(const InternedString& other) const noexcept
+    {
+        return entry_ == other.entry_;
+    }
+
+    bool operator==(std::string_view text) const noexcept
+    {
+        return *entry_ == text;
+    }
+
+    bool operator==(const char* text) const noexcept
+    {
+        return *entry_ == text;
+    }
+
+    size_t hash() const noexcept
+    {
+        return std::hash<const void*> {}(entry_);
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const InternedString& str)
+    {
+        return out << str.view();
+    }
+};
+
+template <>
+struct std::hash<InternedString>
+{
+    size_t operator()(const InternedString& str) const noexcept
+    {
+        return str.hash();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// StringInterner - thread-safe pool of unique strings (strings are never removed)
+//                  sharded by hash - lookup of existing string takes shared lock of one shard
+
+class StringInterner
+{
+    static constexpr size_t shards_count = 16;
+    static constexpr size_t block_size = 64 * 1024;
+
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex mtx;
+        std::unordered_map<std::string_view, const std::string_view*> index;
+        std::deque<std::string_view> entries; // stable addresses
+        std::vector<UniquePtr<char[]>> blocks;
+        char* free_chars {};
+        size_t free_chars_count {};
+        size_t chars_bytes {};
+
+        // copies text (with null terminator) into arena block
+        std::string_view store(std::string_view text)
+        {
+            const size_t size = text.size() + 1;
+
+            if (size > free_chars_count)
+            {
+                const size_t new_block_size = std::max(block_size, size);
+                blocks.push_back(MakeUnique<char[]>(new_block_size));
+                free_chars = blocks.back().get();
+                free_chars_count = new_block_size;
+                chars_bytes += new_block_size;
+            }
+
+            char* chars = free_chars;
+            std::memcpy(chars, text.data(), text.size());
+            chars[text.size()] = '\0';
+
+            free_chars += size;
+            free_chars_count -= size;
+
+            return std::string_view {chars, text.size()};
+        }
+    };
+
+    std::array<Shard, shards_count> shards_;
+
+    Shard& shard_for(std::string_view text) noexcept
+    {
+        return shards_[std::hash<std::string_view> {}(text) % shards_count];
+    }
+
+public:
+    StringInterner() = default;
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    static StringInterner& global()
+    {
+        static StringInterner interner;
+        return interner;
+    }
+
+    InternedString intern(std::string_view text)
+    {
+        if (text.empty())
+            return InternedString {};
+
+        Shard& shard = shard_for(text);
+
+        {
+            std::shared_lock lk {shard.mtx};
+            if (auto it = shard.index.find(text); it != shard.index.end())
+                return InternedString {it->second};
+        }
+
+        std::unique_lock lk {shard.mtx};
+        if (auto it = shard.index.find(text); it != shard.index.end()) // interned by other thread
+            return InternedString {it->second};
+
+        const std::string_view* entry = &shard.entries.emplace_back(shard.store(text));
+        shard.index.emplace(*entry, entry);
+
+        return InternedString {entry};
+    }
+
+    // number of unique strings
+    size_t size() const
+    {
+        size_t result = 0;
+        for (const auto& shard : shards_)
+        {
+            std::shared_lock lk {shard.mtx};
+            result += shard.entries.size();
+        }
+        return result;
+    }
+
+    // bytes of arena blocks holding chars of interned strings
+    size_t chars_bytes() const
+    {
+        size_t result = 0;
+        for (const auto& shard : shards_)
+        {
+            std::shared_lock lk {shard.mtx};
+            result += shard.chars_bytes;
+        }
+        return result;
+    }
+};
+
+inline InternedString::InternedString(std::string_view text)
+    : InternedString {StringInterner::global().intern(text)}
+{
+}
+
+#endif
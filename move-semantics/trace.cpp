@@ -0,0 +1,76 @@
+#include "catch.hpp"
+#include "data.hpp"
+#include "trace.hpp"
+#include <sstream>
+
+namespace
+{
+    // restores std::cout buffer also when failed REQUIRE leaves test by exception
+    class CoutRedirect
+    {
+        std::streambuf* previous_;
+
+    public:
+        explicit CoutRedirect(std::ostream& target)
+            : previous_ {std::cout.rdbuf(target.rdbuf())}
+        {
+        }
+
+        CoutRedirect(const CoutRedirect&) = delete;
+        CoutRedirect& operator=(const CoutRedirect&) = delete;
+
+        ~CoutRedirect()
+        {
+            std::cout.rdbuf(previous_);
+        }
+    };
+}
+
+TEST_CASE("Trace sinks")
+{
+    Trace::BufferedSink::flush();
+
+    std::ostringstream captured;
+    CoutRedirect redirect {captured};
+
+    SECTION("NullSink discards traces")
+    {
+        Trace::NullSink::write("Data(", "ds1", ")\n");
+        Trace::NullSink::flush();
+
+        REQUIRE(captured.str().empty());
+    }
+
+    SECTION("CountingSink counts traces")
+    {
+        const size_t start = Trace::CountingSink::count;
+
+        Trace::CountingSink::write("Data(", "ds1", ")\n");
+        Trace::CountingSink::write("Data(", "ds2", ")\n");
+
+        REQUIRE(Trace::CountingSink::count - start == 2);
+        REQUIRE(captured.str().empty());
+    }
+
+    SECTION("BufferedSink writes traces on flush")
+    {
+        Trace::BufferedSink::write("Data(", "ds1", ")\n");
+        Trace::BufferedSink::write("Gadget(", 1, ")\n");
+
+        REQUIRE(captured.str().empty());
+
+        Trace::BufferedSink::flush();
+
+        REQUIRE(captured.str() == "Data(ds1)\nGadget(1)\n");
+    }
+}
+
+TEST_CASE("Data traces", "[.][benchmark]")
+{
+    BENCHMARK("Data - construction with traces")
+    {
+        return Data {"ds-large", {1, 2, 53, 45, 645, 75647, 7561, 2, 3, 4, 5}};
+    };
+
+    Trace::flush();
+}
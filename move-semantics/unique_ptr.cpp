@@ -0,0 +1,176 @@
+#include "catch.hpp"
+#include "alloc_stats.hpp"
+#include "gadget.hpp"
+#include "unique_ptr.hpp"
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+    struct FileCloser
+    {
+        void operator()(FILE* file) const noexcept
+        {
+            std::fclose(file);
+        }
+    };
+
+    struct CountingDelete
+    {
+        int* counter;
+
+        void operator()(Gadget* ptr) const noexcept
+        {
+            ++*counter;
+            delete ptr;
+        }
+    };
+
+    void free_int(int* ptr)
+    {
+        delete ptr;
+    }
+
+    struct Base
+    {
+        virtual ~Base() = default;
+    };
+
+    struct Derived : Base
+    {
+    };
+}
+
+// stateless deleters take no space
+static_assert(sizeof(UniquePtr<Gadget>) == sizeof(Gadget*));
+static_assert(sizeof(UniquePtr<int[]>) == sizeof(int*));
+static_assert(sizeof(UniquePtr<FILE, FileCloser>) == sizeof(FILE*));
+static_assert(sizeof(UniquePtr<int, void (*)(int*)>) == 2 * sizeof(int*));
+static_assert(sizeof(UniquePtr<Gadget, CountingDelete>) == 2 * sizeof(int*));
+
+TEST_CASE("UniquePtr - operator* returns reference")
+{
+    UniquePtr<Gadget> g = MakeUnique<Gadget>(1, "ipad");
+
+    Gadget& ref = *g;
+    REQUIRE(&ref == g.get());
+    REQUIRE((*g).name == "ipad");
+}
+
+TEST_CASE("UniquePtr - custom deleters")
+{
+    SECTION("stateful deleter")
+    {
+        int deleted = 0;
+        {
+            UniquePtr<Gadget, CountingDelete> g {new Gadget {1}, CountingDelete {&deleted}};
+            UniquePtr<Gadget, CountingDelete> target = std::move(g);
+
+            REQUIRE(g.get() == nullptr);
+            REQUIRE(target.get_deleter().counter == &deleted);
+        }
+        REQUIRE(deleted == 1);
+    }
+
+    SECTION("function pointer")
+    {
+        UniquePtr<int, void (*)(int*)> ptr {new int {42}, &free_int};
+        REQUIRE(*ptr == 42);
+    }
+
+    SECTION("reset & release")
+    {
+        int deleted = 0;
+        UniquePtr<Gadget, CountingDelete> g {new Gadget {1}, CountingDelete {&deleted}};
+
+        g.reset(new Gadget {2});
+        REQUIRE(deleted == 1);
+
+        Gadget* raw = g.release();
+        REQUIRE(g.get() == nullptr);
+        delete raw;
+        REQUIRE(deleted == 1);
+    }
+
+    SECTION("stateless deleter for C resources")
+    {
+        UniquePtr<FILE, FileCloser> file {std::tmpfile()};
+        REQUIRE(file);
+    }
+}
+
+TEST_CASE("UniquePtr - converting move from derived")
+{
+    UniquePtr<Derived> derived = MakeUnique<Derived>();
+    Derived* raw = derived.get();
+
+    UniquePtr<Base> base = std::move(derived);
+
+    REQUIRE(base.get() == raw);
+    REQUIRE(derived.get() == nullptr);
+}
+
+TEST_CASE("UniquePtr<T[]> - arrays")
+{
+    AllocStats::Scope alloc_scope;
+    UniquePtr<int[]> items = MakeUnique<int[]>(100);
+    const size_t allocations = alloc_scope.allocations();
+
+    REQUIRE(allocations == 1);
+
+    std::iota(items.get(), items.get() + 100, 0);
+    REQUIRE(items[99] == 99);
+
+    UniquePtr<int[]> target = std::move(items);
+    REQUIRE(target[0] == 0);
+    REQUIRE_FALSE(items);
+
+    UniquePtr<Gadget[]> gadgets = MakeUnique<Gadget[]>(3);
+    REQUIRE(gadgets[2].name == "not-set");
+}
+
+TEST_CASE("UniquePtr vs. raw pointer - codegen", "[.][benchmark]")
+{
+    const int count = 10'000;
+
+    std::vector<int*> raw_ptrs(count);
+    std::vector<UniquePtr<int>> unique_ptrs(count);
+
+    // pointers escape into vectors - allocations can't be elided
+    BENCHMARK("int* - new/delete")
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            delete raw_ptrs[i];
+            raw_ptrs[i] = new int {i};
+        }
+        return raw_ptrs.back();
+    };
+
+    BENCHMARK("UniquePtr<int> - MakeUnique")
+    {
+        for (int i = 0; i < count; ++i)
+            unique_ptrs[i] = MakeUnique<int>(i);
+        return unique_ptrs.back().get();
+    };
+
+    BENCHMARK("std::vector<int*> - scan")
+    {
+        long long sum = 0;
+        for (int* ptr : raw_ptrs)
+            sum += *ptr;
+        return sum;
+    };
+
+    BENCHMARK("std::vector<UniquePtr<int>> - scan")
+    {
+        long long sum = 0;
+        for (const auto& ptr : unique_ptrs)
+            sum += *ptr;
+        return sum;
+    };
+
+    for (int* ptr : raw_ptrs)
+        delete ptr;
+}
@@ -0,0 +1,387 @@
+#ifndef UNIQUE_PTR_HPP
+#define UNIQUE_PTR_HPP
+
+#include "instrumentation.hpp"
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////
+// DefaultDelete - deleter used by UniquePtr (delete for objects, delete[] for arrays)
+
+template <typename T>
+struct DefaultDelete
+{
+    DefaultDelete() = default;
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    DefaultDelete(const DefaultDelete<U>&) noexcept
+    {
+    }
+
+    void operator()(T* ptr) const noexcept
+    {
+        static_assert(sizeof(T) > 0, "can't delete incomplete type");
+        delete ptr;
+    }
+};
+
+template <typename T>
+struct DefaultDelete<T[]>
+{
+    void operator()(T* ptr) const noexcept
+    {
+        static_assert(sizeof(T) > 0, "can't delete incomplete type");
+        delete[] ptr;
+    }
+};
+
+namespace Detail
+{
+    ////////////////////////////////////////////////////////////////////////////
+    // PtrAndDeleter - pointer + deleter, empty deleter takes no space (empty-base optimization)
+
+    template <typename T, typename TDeleter, bool IsEmptyBase = std::is_empty_v<TDeleter> && !std::is_final_v<TDeleter>>
+    class PtrAndDeleter : private TDeleter
+    {
+        T* ptr_;
+
+    public:
+        template <typename TD>
+        PtrAndDeleter(T* ptr, TD&& deleter) noexcept
+            : TDeleter(std::forward<TD>(deleter))
+            , ptr_ {ptr}
+        {
+        }
+
+        T*& ptr() noexcept
+        {
+            return ptr_;
+        }
+
+        T* ptr() const noexcept
+        {
+            return ptr_;
+        }
+
+        TDeleter& deleter() noexcept
+        {
+            return *this;
+        }
+
+        const TDeleter& deleter() const noexcept
+        {
+            return *this;
+        }
+    };
+
+    template <typename T, typename TDeleter>
+    class PtrAndDeleter<T, TDeleter, false>
+    {
+        T* ptr_;
+        TDeleter deleter_;
+
+    public:
+        template <typename TD>
+        PtrAndDeleter(T* ptr, TD&& deleter) noexcept
+            : ptr_ {ptr}
+            , deleter_(std::forward<TD>(deleter))
+        {
+        }
+
+        T*& ptr() noexcept
+        {
+            return ptr_;
+        }
+
+        T* ptr() const noexcept
+        {
+            return ptr_;
+        }
+
+        TDeleter& deleter() noexcept
+        {
+            return deleter_;
+        }
+
+        const TDeleter& deleter() const noexcept
+        {
+            return deleter_;
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////
+// UniquePtr - exclusive ownership of object, released with TDeleter
+//             stateless deleter keeps UniquePtr pointer-sized
+
+template <typename T, typename TDeleter = DefaultDelete<T>>
+class UniquePtr
+{
+    Detail::PtrAndDeleter<T, TDeleter> impl_;
+
+public:
+    using element_type = T;
+    using deleter_type = TDeleter;
+
+    UniquePtr(std::nullptr_t) noexcept
+        : impl_ {nullptr, TDeleter {}}
+    {
+    }
+
+    UniquePtr() noexcept
+        : impl_ {nullptr, TDeleter {}}
+    {
+    }
+
+    explicit UniquePtr(T* ptr) noexcept
+        : impl_ {ptr, TDeleter {}}
+    {
+    }
+
+    UniquePtr(T* ptr, const TDeleter& deleter) noexcept
+        : impl_ {ptr, deleter}
+    {
+    }
+
+    UniquePtr(T* ptr, TDeleter&& deleter) noexcept
+        : impl_ {ptr, std::move(deleter)}
+    {
+    }
+
+    UniquePtr(const UniquePtr&) = delete;
+    UniquePtr& operator=(const UniquePtr&) = delete;
+
+    // move constructor
+    UniquePtr(UniquePtr&& other) noexcept
+        : impl_ {other.release(), std::forward<TDeleter>(other.get_deleter())}
+    {
+        Instrumentation::record<UniquePtr>(Instrumentation::Event::move_construction);
+    }
+
+    // converting move constructor - UniquePtr<Derived> -> UniquePtr<Base>
+    template <typename U, typename E,
+        typename = std::enable_if_t<std::is_convertible_v<U*, T*> && std::is_convertible_v<E, TDeleter>>>
+    UniquePtr(UniquePtr<U, E>&& other) noexcept
+        : impl_ {other.release(), std::forward<E>(other.get_deleter())}
+    {
+        Instrumentation::record<UniquePtr>(Instrumentation::Event::move_construction);
+    }
+
+    // move assignment
+    UniquePtr& operator=(UniquePtr&& other) noexcept
+    {
+        Instrumentation::record<UniquePtr>(Instrumentation::Event::move_assignment);
+
+        if (this != &other)
+        {
+            reset(other.release());
+            get_deleter() = std::forward<TDeleter>(other.get_deleter());
+        }
+
+        return *this;
+    }
+
+    UniquePtr& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    ~UniquePtr() noexcept
+    {
+        if (impl_.ptr())
+            get_deleter()(impl_.ptr());
+    }
+
+    T* release() noexcept
+    {
+        return std::exchange(impl_.ptr(), nullptr);
+    }
+
+    void reset(T* ptr = nullptr) noexcept
+    {
+        T* old_ptr = std::exchange(impl_.ptr(), ptr);
+        if (old_ptr)
+            get_deleter()(old_ptr);
+    }
+
+    void swap(UniquePtr& other) noexcept
+    {
+        std::swap(impl_, other.impl_);
+    }
+
+    TDeleter& get_deleter() noexcept
+    {
+        return impl_.deleter();
+    }
+
+    const TDeleter& get_deleter() const noexcept
+    {
+        return impl_.deleter();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return impl_.ptr() != nullptr;
+    }
+
+    T* get() const noexcept
+    {
+        return impl_.ptr();
+    }
+
+    T* operator->() const noexcept
+    {
+        return impl_.ptr();
+    }
+
+    T& operator*() const noexcept
+    {
+        assert(impl_.ptr() != nullptr);
+        return *impl_.ptr();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// UniquePtr<T[]> - exclusive ownership of dynamic array (operator[] instead of -> and *)
+
+template <typename T, typename TDeleter>
+class UniquePtr<T[], TDeleter>
+{
+    Detail::PtrAndDeleter<T, TDeleter> impl_;
+
+public:
+    using element_type = T;
+    using deleter_type = TDeleter;
+
+    UniquePtr(std::nullptr_t) noexcept
+        : impl_ {nullptr, TDeleter {}}
+    {
+    }
+
+    UniquePtr() noexcept
+        : impl_ {nullptr, TDeleter {}}
+    {
+    }
+
+    explicit UniquePtr(T* ptr) noexcept
+        : impl_ {ptr, TDeleter {}}
+    {
+    }
+
+    UniquePtr(T* ptr, const TDeleter& deleter) noexcept
+        : impl_ {ptr, deleter}
+    {
+    }
+
+    UniquePtr(T* ptr, TDeleter&& deleter) noexcept
+        : impl_ {ptr, std::move(deleter)}
+    {
+    }
+
+    UniquePtr(const UniquePtr&) = delete;
+    UniquePtr& operator=(const UniquePtr&) = delete;
+
+    UniquePtr(UniquePtr&& other) noexcept
+        : impl_ {other.release(), std::forward<TDeleter>(other.get_deleter())}
+    {
+        Instrumentation::record<UniquePtr>(Instrumentation::Event::move_construction);
+    }
+
+    UniquePtr& operator=(UniquePtr&& other) noexcept
+    {
+        Instrumentation::record<UniquePtr>(Instrumentation::Event::move_assignment);
+
+        if (this != &other)
+        {
+            reset(other.release());
+            get_deleter() = std::forward<TDeleter>(other.get_deleter());
+        }
+
+        return *this;
+    }
+
+    UniquePtr& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    ~UniquePtr() noexcept
+    {
+        if (impl_.ptr())
+            get_deleter()(impl_.ptr());
+    }
+
+    T* release() noexcept
+    {
+        return std::exchange(impl_.ptr(), nullptr);
+    }
+
+    void reset(T* ptr = nullptr) noexcept
+    {
+        T* old_ptr = std::exchange(impl_.ptr(), ptr);
+        if (old_ptr)
+            get_deleter()(old_ptr);
+    }
+
+    void swap(UniquePtr& other) noexcept
+    {
+        std::swap(impl_, other.impl_);
+    }
+
+    TDeleter& get_deleter() noexcept
+    {
+        return impl_.deleter();
+    }
+
+    const TDeleter& get_deleter() const noexcept
+    {
+        return impl_.deleter();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return impl_.ptr() != nullptr;
+    }
+
+    T* get() const noexcept
+    {
+        return impl_.ptr();
+    }
+
+    T& operator[](size_t index) const noexcept
+    {
+        assert(impl_.ptr() != nullptr);
+        return impl_.ptr()[index];
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// MakeUnique<T>(args...) - object initialized with args
+// MakeUnique<T[]>(size)  - array of default-initialized items (no zeroing of trivial types)
+
+template <typename T, typename... TArgs>
+std::enable_if_t<!std::is_array_v<T>, UniquePtr<T>> MakeUnique(TArgs&&... args)
+{
+    Instrumentation::record_allocation<UniquePtr<T>>(sizeof(T));
+
+    return UniquePtr<T>(new T(std::forward<TArgs>(args)...));
+}
+
+template <typename T>
+std::enable_if_t<std::is_unbounded_array_v<T>, UniquePtr<T>> MakeUnique(size_t size)
+{
+    using TItem = std::remove_extent_t<T>;
+
+    Instrumentation::record_allocation<UniquePtr<T>>(size * sizeof(TItem));
+
+    return UniquePtr<T>(new TItem[size]);
+}
+
+template <typename T, typename... TArgs>
+std::enable_if_t<std::is_bounded_array_v<T>> MakeUnique(TArgs&&...) = delete;
+
+#endif
@@ -1,6 +1,9 @@
 #include "catch.hpp"
 #include <iostream>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -60,33 +63,231 @@ TEST_CASE("nullptr")
 
 namespace ModernCpp
 {
-    template <typename T>
+    namespace Detail
+    {
+        // pointer + deleter - empty deleter takes no space (empty-base optimization),
+        // function pointers, final & stateful deleters are stored as members
+        template <typename T, typename TDeleter, bool IsEmptyBase = std::is_empty<TDeleter>::value && !std::is_final<TDeleter>::value>
+        class PtrAndDeleter : private TDeleter
+        {
+            T* ptr_;
+
+        public:
+            template <typename TD>
+            PtrAndDeleter(T* ptr, TD&& deleter) noexcept
+                : TDeleter(std::forward<TD>(deleter))
+                , ptr_ {ptr}
+            {
+            }
+
+            T*& ptr() noexcept
+            {
+                return ptr_;
+            }
+
+            T* ptr() const noexcept
+            {
+                return ptr_;
+            }
+
+            TDeleter& deleter() noexcept
+            {
+                return *this;
+            }
+        };
+
+        template <typename T, typename TDeleter>
+        class PtrAndDeleter<T, TDeleter, false>
+        {
+            T* ptr_;
+            TDeleter deleter_;
+
+        public:
+            template <typename TD>
+            PtrAndDeleter(T* ptr, TD&& deleter) noexcept
+                : ptr_ {ptr}
+                , deleter_(std::forward<TD>(deleter))
+            {
+            }
+
+            T*& ptr() noexcept
+            {
+                return ptr_;
+            }
+
+            T* ptr() const noexcept
+            {
+                return ptr_;
+            }
+
+            TDeleter& deleter() noexcept
+            {
+                return deleter_;
+            }
+        };
+    }
+
+    template <typename T, typename TDeleter = std::default_delete<T>>
     class UniquePtr
     {
-        T* ptr_;
+        Detail::PtrAndDeleter<T, TDeleter> impl_;
 
     public:
-        explicit UniquePtr(T* ptr) noexcept
-            : ptr_ {ptr}
+        explicit UniquePtr(T* ptr, TDeleter deleter = TDeleter {}) noexcept
+            : impl_ {ptr, std::move(deleter)}
         {
         }
 
         UniquePtr(nullptr_t) noexcept
-            : ptr_ {nullptr}
+            : impl_ {nullptr, TDeleter {}}
         {
         }
 
         UniquePtr(const UniquePtr&) = delete;
         UniquePtr& operator=(const UniquePtr&) = delete;
 
-        UniquePtr(UniquePtr&& other) : ptr_{other.ptr_}
+        UniquePtr(UniquePtr&& other) noexcept
+            : impl_ {other.release(), std::move(other.impl_.deleter())}
         {
-            other.ptr_ = nullptr;
+        }
+
+        UniquePtr& operator=(UniquePtr&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset(other.release());
+                impl_.deleter() = std::move(other.impl_.deleter());
+            }
+
+            return *this;
         }
 
         ~UniquePtr()
         {
-            delete ptr_;
+            reset();
+        }
+
+        T* release() noexcept
+        {
+            return std::exchange(impl_.ptr(), nullptr);
+        }
+
+        void reset(T* ptr = nullptr) noexcept
+        {
+            T* old_ptr = std::exchange(impl_.ptr(), ptr);
+            if (old_ptr)
+                impl_.deleter()(old_ptr);
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return impl_.ptr() != nullptr;
+        }
+
+        T* get() const noexcept
+        {
+            return impl_.ptr();
+        }
+
+        T* operator->() const noexcept
+        {
+            return impl_.ptr();
+        }
+
+        T& operator*() const noexcept
+        {
+            return *impl_.ptr();
+        }
+    };
+
+    template <typename T, typename TDeleter>
+    class UniquePtr<T[], TDeleter>
+    {
+        Detail::PtrAndDeleter<T, TDeleter> impl_;
+
+    public:
+        explicit UniquePtr(T* ptr, TDeleter deleter = TDeleter {}) noexcept
+            : impl_ {ptr, std::move(deleter)}
+        {
+        }
+
+        UniquePtr(nullptr_t) noexcept
+            : impl_ {nullptr, TDeleter {}}
+        {
+        }
+
+        UniquePtr(const UniquePtr&) = delete;
+        UniquePtr& operator=(const UniquePtr&) = delete;
+
+        UniquePtr(UniquePtr&& other) noexcept
+            : impl_ {other.release(), std::move(other.impl_.deleter())}
+        {
+        }
+
+        UniquePtr& operator=(UniquePtr&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset(other.release());
+                impl_.deleter() = std::move(other.impl_.deleter());
+            }
+
+            return *this;
+        }
+
+        ~UniquePtr()
+        {
+            reset();
+        }
+
+        T* release() noexcept
+        {
+            return std::exchange(impl_.ptr(), nullptr);
+        }
+
+        void reset(T* ptr = nullptr) noexcept
+        {
+            T* old_ptr = std::exchange(impl_.ptr(), ptr);
+            if (old_ptr)
+                impl_.deleter()(old_ptr);
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return impl_.ptr() != nullptr;
+        }
+
+        T* get() const noexcept
+        {
+            return impl_.ptr();
+        }
+
+        T& operator[](size_t index) const noexcept
+        {
+            return impl_.ptr()[index];
+        }
+    };
+
+    static_assert(sizeof(UniquePtr<int>) == sizeof(int*), "stateless deleter must not take space");
+    static_assert(sizeof(UniquePtr<int[]>) == sizeof(int*), "stateless deleter must not take space");
+}
+
+namespace
+{
+    int deleted_count = 0;
+
+    void counting_delete(int* ptr)
+    {
+        ++deleted_count;
+        delete ptr;
+    }
+
+    struct FinalDelete final
+    {
+        void operator()(int* ptr) const
+        {
+            ++deleted_count;
+            delete ptr;
         }
     };
 }
@@ -97,4 +298,35 @@ TEST_CASE("using nullptr_t in smart ptrs")
 
     UniquePtr<int> sp1 {new int(13)};
     UniquePtr<int> sp2 = nullptr;
-}
\ No newline at end of file
+
+    REQUIRE(*sp1 == 13);
+    REQUIRE_FALSE(sp2);
+
+    UniquePtr<int[]> sp3 {new int[3] {1, 2, 3}};
+    REQUIRE(sp3[2] == 3);
+
+    SECTION("function pointer & final deleters")
+    {
+        deleted_count = 0;
+        {
+            UniquePtr<int, void (*)(int*)> fp {new int(1), &counting_delete};
+            UniquePtr<int, FinalDelete> fd {new int(2)};
+
+            UniquePtr<int, void (*)(int*)> target = nullptr;
+            target = std::move(fp);
+            REQUIRE_FALSE(fp);
+            REQUIRE(*target == 1);
+            REQUIRE(*fd == 2);
+        }
+        REQUIRE(deleted_count == 2);
+    }
+
+    SECTION("move assignment releases previous object")
+    {
+        UniquePtr<int> target {new int(1)};
+        target = std::move(sp1);
+
+        REQUIRE(*target == 13);
+        REQUIRE_FALSE(sp1);
+    }
+}
@@ -1,4 +1,5 @@
 #include "catch.hpp"
+#include "trace.hpp"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -13,7 +14,7 @@ struct X
     X(int v, const string& name) :
         value{v}
     {
-        cout << "X(" << value << ", " << name << ")\n";
+        Trace::write("X(", value, ", ", name, ")\n");
     }
 
     X()
@@ -21,7 +22,7 @@ struct X
         static int gen_id = 0;
         value = ++gen_id;
 
-        cout << "X(" << value << ")\n";
+        Trace::write("X(", value, ")\n");
     }
 
     X(const X&) = delete;
@@ -31,7 +32,7 @@ struct X
 
     ~X()
     {
-        cout << "~X(" << value << ")\n";
+        Trace::write("~X(", value, ")\n");
     }
 };
 
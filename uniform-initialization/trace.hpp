@@ -0,0 +1,133 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <atomic>
+#include <iostream>
+#include <sstream>
+
+////////////////////////////////////////////////////////////////////////////
+// Trace - constructor/destructor traces routed to a sink selected at compile time
+//         TRACE_SINK_NONE     - traces are discarded (no code is generated)
+//         TRACE_SINK_COUNTERS - only number of traces is counted
+//         TRACE_SINK_BUFFERED - traces are buffered per thread and written to std::cout in chunks
+//         (default)           - traces are written to std::cout
+
+namespace Trace
+{
+    struct NullSink
+    {
+        static constexpr bool enabled = false;
+
+        template <typename... TArgs>
+        static void write(const TArgs&...) noexcept
+        {
+        }
+
+        static void flush() noexcept
+        {
+        }
+    };
+
+    struct StdoutSink
+    {
+        static constexpr bool enabled = true;
+
+        template <typename... TArgs>
+        static void write(const TArgs&... args)
+        {
+            (std::cout << ... << args);
+        }
+
+        static void flush()
+        {
+            std::cout.flush();
+        }
+    };
+
+    struct CountingSink
+    {
+        static constexpr bool enabled = true;
+
+        static inline std::atomic<size_t> count {};
+
+        template <typename... TArgs>
+        static void write(const TArgs&...) noexcept
+        {
+            count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static void flush() noexcept
+        {
+        }
+    };
+
+    class BufferedSink
+    {
+        static constexpr std::streamoff capacity = 64 * 1024;
+
+        struct Buffer
+        {
+            std::ostringstream out;
+
+            ~Buffer()
+            {
+                flush_to(std::cout);
+            }
+
+            void flush_to(std::ostream& target)
+            {
+                target << out.str();
+                out.str({});
+            }
+        };
+
+        static Buffer& buffer()
+        {
+            static thread_local Buffer thread_buffer;
+            return thread_buffer;
+        }
+
+    public:
+        static constexpr bool enabled = true;
+
+        template <typename... TArgs>
+        static void write(const TArgs&... args)
+        {
+            Buffer& buf = buffer();
+            (buf.out << ... << args);
+
+            if (buf.out.tellp() >= capacity)
+                buf.flush_to(std::cout);
+        }
+
+        // writes traces buffered by the calling thread
+        static void flush()
+        {
+            buffer().flush_to(std::cout);
+        }
+    };
+
+#if defined(TRACE_SINK_NONE)
+    using Sink = NullSink;
+#elif defined(TRACE_SINK_COUNTERS)
+    using Sink = CountingSink;
+#elif defined(TRACE_SINK_BUFFERED)
+    using Sink = BufferedSink;
+#else
+    using Sink = StdoutSink;
+#endif
+
+    template <typename... TArgs>
+    inline void write(const TArgs&... args)
+    {
+        if constexpr (Sink::enabled)
+            Sink::write(args...);
+    }
+
+    inline void flush()
+    {
+        Sink::flush();
+    }
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "catch.hpp"
+#include "trace.hpp"
 
 #include <iostream>
 #include <list>
@@ -201,13 +202,13 @@ public:
     Polygon(std::vector<Point> lst)
         : points {std::move(lst)}
     {
-        std::cout << "Polygon(std::vector<Point> lst)\n";
+        Trace::write("Polygon(std::vector<Point> lst)\n");
     }
 
     Polygon(std::initializer_list<Point> lst)
         : points {lst}
     {
-        std::cout << "Polygon(std::initializer_list<Point> lst)\n";
+        Trace::write("Polygon(std::initializer_list<Point> lst)\n");
     }
     Point& operator[](size_t i)
     {